@@ -2,6 +2,7 @@
 #define BLOCK_SYSTEM_H
 
 #include "game_types.h"
+#include "game_context.h"
 
 // 路障系统常量
 #define BLOCK_RANGE 10          // 路障放置最大距离
@@ -11,55 +12,54 @@
 #define BOMB_RANGE 10           // 炸弹放置最大距离
 #define BOMB_SYMBOL '@'         // 炸弹在地图上的显示符号
 #define HOSPITAL_DAYS 3         // 炸弹爆炸后住院天数
-#define HOSPITAL_LOCATION 14    // 医院位置
 
 // 机器娃娃系统常量
 #define ROBOT_CLEAR_RANGE 10    // 机器娃娃清除范围（前方10步）
 
 // 路障命令处理函数
-bool handle_block_command(Player* player, int relative_distance);
+bool handle_block_command(GameContext* ctx, Player* player, int relative_distance);
 
 // 炸弹命令处理函数
-bool handle_bomb_command(Player* player, int relative_distance);
+bool handle_bomb_command(GameContext* ctx, Player* player, int relative_distance);
 
 // 机器娃娃命令处理函数
-bool handle_robot_command(Player* player);
+bool handle_robot_command(GameContext* ctx, Player* player);
 
 // 路障放置相关函数
-bool place_block(int player_index, int target_location);
+bool place_block(GameContext* ctx, int player_index, int target_location);
 bool is_valid_block_position(int current_pos, int relative_distance);
-int calculate_block_position(int current_pos, int relative_distance);
+int calculate_block_position(const Board* board, int current_pos, int relative_distance);
 
 // 炸弹放置相关函数
-bool place_bomb(int player_index, int target_location);
+bool place_bomb(GameContext* ctx, int player_index, int target_location);
 bool is_valid_bomb_position(int current_pos, int relative_distance);
 int calculate_bomb_position(int current_pos, int relative_distance);
 
 // 路障拦截相关函数
-bool check_block_interception(int location);
-void trigger_block_interception(Player* player, int location);
-void remove_block(int location);
+bool check_block_interception(GameContext* ctx, int location);
+void trigger_block_interception(GameContext* ctx, Player* player, int location);
+void remove_block(GameContext* ctx, int location);
 
 // 炸弹爆炸相关函数
-bool check_bomb_explosion(int location);
-void trigger_bomb_explosion(Player* player, int location);
-void remove_bomb(int location);
+bool check_bomb_explosion(GameContext* ctx, int location);
+void trigger_bomb_explosion(GameContext* ctx, Player* player, int location);
+void remove_bomb(GameContext* ctx, int location);
 
 // 路障查询函数
-bool has_block_at_location(int location);
-void display_all_blocks(void);
+bool has_block_at_location(GameContext* ctx, int location);
+void display_all_blocks(GameContext* ctx);
 
 // 炸弹查询函数
-void display_all_bombs(void);
+void display_all_bombs(GameContext* ctx);
 
 // 机器娃娃清除功能函数
-int clear_props_in_range(Player* player, int start_location, int range);
-int clear_single_prop(int location);
-bool has_any_prop_at_location(int location);
+int clear_props_in_range(GameContext* ctx, Player* player, int start_location, int range);
+int clear_single_prop(GameContext* ctx, int location);
+bool has_any_prop_at_location(GameContext* ctx, int location);
 
 // 位置检查辅助函数
 bool is_special_building(int location);
-bool has_player_at_location(int location);
-bool has_bomb_at_location(int location);
+bool has_player_at_location(GameContext* ctx, int location);
+bool has_bomb_at_location(GameContext* ctx, int location);
 
 #endif // BLOCK_SYSTEM_H
@@ -0,0 +1,143 @@
+#include "board.h"
+#include <stdio.h>
+#include <string.h>
+
+#define CLASSIC_SIZE 70
+#define CLASSIC_ROWS 8
+#define CLASSIC_COLS 29
+
+static Board s_classic;
+static const Board* s_active = NULL;
+
+// 经典地图各位置的地图字符
+static char classic_symbol(int location) {
+    if (location == 0) return 'S';
+    if (location >= 1 && location <= 13) return '0';
+    if (location == 14) return 'P';
+    if (location >= 15 && location <= 27) return '0';
+    if (location == 28) return 'T';
+    if (location >= 29 && location <= 35) return '0';
+    if (location == 36) return 'G';
+    if (location >= 37 && location <= 48) return '0';
+    if (location == 49) return 'P';
+    if (location >= 50 && location <= 62) return '0';
+    if (location == 63) return 'P';
+    if (location >= 64 && location <= 69) return '$';
+    return ' ';
+}
+
+// 经典地图各位置所属地段 (1-3)，特殊位置返回 0
+static int classic_district(int location) {
+    if ((location >= 1 && location <= 13) || (location >= 15 && location <= 27)) {
+        return 1;
+    } else if (location >= 29 && location <= 34) {
+        return 2;
+    } else if ((location >= 36 && location <= 48) || (location >= 50 && location <= 62)) {
+        return 3;
+    }
+    return 0;
+}
+
+static void init_classic_tiles(Board* board) {
+    // 矿地点数：从上到下依次为 20、80、100、40、80、60
+    static const int mine_credits[] = {60, 80, 40, 100, 80, 20};
+
+    for (int loc = 0; loc < CLASSIC_SIZE; loc++) {
+        Tile* tile = &board->tiles[loc];
+        tile->symbol = classic_symbol(loc);
+        tile->district = (unsigned char)classic_district(loc);
+        tile->price = board->district_price[tile->district];
+        tile->credit = 0;
+        tile->kind = TILE_LAND;
+    }
+    board->tiles[0].kind = TILE_START;
+    board->tiles[14].kind = TILE_PARK;  // 医院 -> 公园
+    board->tiles[49].kind = TILE_PARK;  // 监狱 -> 公园
+    board->tiles[63].kind = TILE_PARK;  // 魔法屋 -> 公园
+    board->tiles[28].kind = TILE_PROP_SHOP;
+    board->tiles[35].kind = TILE_GIFT_HOUSE;
+    for (int i = 0; i < 6; i++) {
+        board->tiles[64 + i].kind = TILE_MINE;
+        board->tiles[64 + i].credit = mine_credits[i];
+    }
+}
+
+// 经典地图的显示布局：玩家和财神按 tile_cell 放置，房屋和路障沿用原有的底行换算方式
+static void init_classic_layout(Board* board) {
+    board->rows = CLASSIC_ROWS;
+    board->cols = CLASSIC_COLS;
+    for (int c = 0; c < CLASSIC_ROWS * CLASSIC_COLS; c++) {
+        board->cell_occupant[c] = -1;
+        board->cell_tile[c] = -1;
+        board->cell_base[c] = ' ';
+    }
+
+    for (int loc = 0; loc < CLASSIC_SIZE; loc++) {
+        int row = -1, col = -1;
+        if (loc >= 0 && loc <= 28) { row = 0; col = loc; }                      // 上边 (S...P...T)
+        else if (loc >= 29 && loc <= 35) { row = loc - 28; col = 28; }          // 右边 (T...G)
+        else if (loc >= 36 && loc <= 63) { row = 7; col = 28 - (loc - 35); }    // 下边 (G...P...M)
+        else if (loc >= 64 && loc <= 69) { row = 7 - (loc - 63); col = 0; }     // 左边 (M...S)
+        board->tile_cell[loc] = (row >= 0) ? row * CLASSIC_COLS + col : -1;
+        if (row >= 0) board->cell_occupant[row * CLASSIC_COLS + col] = loc;
+    }
+
+    for (int i = 0; i < CLASSIC_ROWS; i++) {
+        for (int j = 0; j < CLASSIC_COLS; j++) {
+            int loc = -1;
+            if (i == 0) loc = j;
+            else if (i == 7) {
+                if (j <= 13) loc = 63 - j;
+                else if (j == 14) loc = 49; // P
+                else loc = 36 + (28 - j);
+            }
+            else if (j == 0) loc = 69 - (i - 1);
+            else if (j == 28) loc = 28 + i;
+            board->cell_tile[i * CLASSIC_COLS + j] = loc;
+        }
+    }
+
+    // 静态地图元素
+    char (*base)[CLASSIC_COLS] = (char (*)[CLASSIC_COLS])board->cell_base;
+    base[0][0] = 'S';
+    for (int i = 1; i <= 13; i++) base[0][i] = '0';
+    base[0][14] = 'P';
+    for (int i = 15; i <= 27; i++) base[0][i] = '0';
+    base[0][28] = 'T';
+    for (int i = 1; i <= 6; i++) base[i][28] = '0';
+    base[7][28] = 'G';
+    for (int i = 27; i >= 15; i--) base[7][i] = '0';
+    base[7][14] = 'P';
+    for (int i = 13; i >= 1; i--) base[7][i] = '0';
+    base[7][0] = 'P';
+    for (int i = 1; i <= 6; i++) base[i][0] = '$';
+
+    snprintf(board->header, sizeof(board->header), "            地段 1");
+    snprintf(board->footer, sizeof(board->footer), "            地段 3");
+    snprintf(board->side_label, sizeof(board->side_label), "    地段 2");
+    board->side_label_row = 3;
+}
+
+void board_init(void) {
+    Board* board = &s_classic;
+    memset(board, 0, sizeof(*board));
+    snprintf(board->name, sizeof(board->name), "classic");
+    board->size = CLASSIC_SIZE;
+    board->district_price[1] = 200;
+    board->district_price[2] = 500;
+    board->district_price[3] = 300;
+    init_classic_tiles(board);
+    init_classic_layout(board);
+}
+
+const Board* board_classic(void) {
+    return &s_classic;
+}
+
+const Board* board_active(void) {
+    return s_active ? s_active : board_classic();
+}
+
+void board_select(const Board* board) {
+    s_active = board;
+}
@@ -0,0 +1,79 @@
+#ifndef BOARD_H
+#define BOARD_H
+
+#include "game_types.h"
+
+// 棋盘定义：格子类型、地价、地段和显示布局
+// 加载时编译成按位置/显示格子下标的扁平查找表，游戏过程中只读，所有对局共享
+// 内置经典地图（70 格），也可以从 JSON 文件加载自定义地图（见 io/board_loader.h）
+
+#define BOARD_MAX_ROWS 32                                   // 地图显示行数上限
+#define BOARD_MAX_COLS 128                                  // 地图显示列数上限
+#define BOARD_MAX_CELLS (BOARD_MAX_ROWS * BOARD_MAX_COLS)
+#define BOARD_LABEL_SIZE 64
+
+// 格子类型，决定玩家停留时触发的事件
+typedef enum {
+    TILE_LAND,        // 空地，可购买
+    TILE_START,       // 起点
+    TILE_PARK,        // 公园（医院、监狱、魔法屋均按公园处理）
+    TILE_PROP_SHOP,   // 道具屋
+    TILE_GIFT_HOUSE,  // 礼品屋
+    TILE_MINE         // 矿地，停留获得点数
+} TileKind;
+
+typedef struct {
+    char symbol;           // 地图字符，也用于判断财神能否出现
+    unsigned char kind;    // TileKind
+    unsigned char district; // 所属地段 (1-DISTRICT_COUNT)，特殊位置为 0
+    int price;             // 初始地价，0 表示不可购买
+    int credit;            // 矿地点数
+} Tile;
+
+typedef struct Board {
+    char name[BOARD_LABEL_SIZE];
+    int size;                                       // 格子数
+    int district_price[DISTRICT_COUNT + 1];         // 各地段默认地价，下标为地段编号
+    Tile tiles[MAX_MAP_SIZE];
+
+    // 显示布局：rows 为 0 表示该地图不绘制
+    int rows;
+    int cols;
+    int tile_cell[MAX_MAP_SIZE];        // 位置 -> 显示格子，用于放置玩家和财神，-1 表示不显示
+    int cell_occupant[BOARD_MAX_CELLS]; // tile_cell 的逆映射，格子 -> 玩家所在位置
+    int cell_tile[BOARD_MAX_CELLS];     // 格子 -> 位置，用于显示房屋和路障
+    char cell_base[BOARD_MAX_CELLS];    // 格子的静态地图字符
+    char header[BOARD_LABEL_SIZE];      // 地图上方的标注行
+    char footer[BOARD_LABEL_SIZE];      // 地图下方的标注行
+    char side_label[BOARD_LABEL_SIZE];  // 附在第 side_label_row 行末尾的标注
+    int side_label_row;
+} Board;
+
+// 构建内置经典地图；程序启动时、使用任何地图（包括加载自定义地图）之前调用一次，
+// 此后地图表只读，可在线程间共享
+void board_init(void);
+
+// 当前选用的地图，未选择时为内置经典地图
+// 和 output_select 一样须在创建游戏上下文（以及启动模拟线程）之前调用
+const Board* board_active(void);
+void board_select(const Board* board);
+
+// 内置经典地图
+const Board* board_classic(void);
+
+// 位置是否在地图内
+static inline bool board_contains(const Board* board, int location) {
+    return location >= 0 && location < board->size;
+}
+
+// 位置的地图字符，地图外返回空格
+static inline char board_symbol(const Board* board, int location) {
+    return board_contains(board, location) ? board->tiles[location].symbol : ' ';
+}
+
+// 位置所属地段，特殊位置和地图外返回 0
+static inline int board_district(const Board* board, int location) {
+    return board_contains(board, location) ? board->tiles[location].district : 0;
+}
+
+#endif // BOARD_H
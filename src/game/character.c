@@ -7,6 +7,11 @@
 Character g_characters[MAX_PLAYERS];
 
 void init_characters(void) {
+    // 角色表初始化后只读；已初始化时直接返回，多线程驱动在启动线程前调用一次即可
+    if (g_characters[0].id == 1) {
+        return;
+    }
+
     // 初始化4个预设角色
     g_characters[0].id = 1;
     strcpy(g_characters[0].name, "Q");
@@ -27,32 +32,38 @@ void init_characters(void) {
     strcpy(g_characters[3].name, "J");
     strcpy(g_characters[3].display_name, "金贝贝");
     g_characters[3].color_code = COLOR_YELLOW;
+
+    // 其余编号为机器人角色，只在模拟等超过 4 位玩家的对局中使用
+    for (int i = PRESET_CHARACTER_COUNT; i < MAX_PLAYERS; i++) {
+        g_characters[i].id = i + 1;
+        snprintf(g_characters[i].name, sizeof(g_characters[i].name), "B%d", i + 1);
+        snprintf(g_characters[i].display_name, sizeof(g_characters[i].display_name), "机器人%d", i + 1);
+        g_characters[i].color_code = COLOR_RESET;
+    }
 }
 
 void show_character_selection(void) {
 // ... existing code ...
-    printf("欢迎来到大富翁，请按数字键选择你的角色：\n");
-    for (int i = 0; i < 4; i++) {
-        printf("%d.%s\n", g_characters[i].id, g_characters[i].display_name);
+    output_printf("欢迎来到大富翁，请按数字键选择你的角色：\n");
+    for (int i = 0; i < PRESET_CHARACTER_COUNT; i++) {
+        output_printf("%d.%s\n", g_characters[i].id, g_characters[i].display_name);
     }
 }
 
 Character* get_character_by_id(int id) {
-    for (int i = 0; i < 4; i++) {
-        if (g_characters[i].id == id) {
-            return &g_characters[i];
-        }
+    if (is_valid_character_id(id) && g_characters[id - 1].id == id) {
+        return &g_characters[id - 1];
     }
     return NULL;
 }
 
 Character* get_character_by_index(int index) {
-    if (index >= 0 && index < 4) {
+    if (index >= 0 && index < MAX_PLAYERS) {
         return &g_characters[index];
     }
     return NULL;
 }
 
 bool is_valid_character_id(int id) {
-    return id >= 1 && id <= 4;
+    return id >= 1 && id <= MAX_PLAYERS;
 }
\ No newline at end of file
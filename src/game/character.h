@@ -3,6 +3,8 @@
 
 #include "game_types.h"
 
+#define PRESET_CHARACTER_COUNT 4 // 可在开局时选择的预设角色数，其余编号为模拟用的机器人
+
 // 函数声明
 void init_characters(void);
 void show_character_selection(void);
@@ -0,0 +1,164 @@
+#include "decision.h"
+#include "game_context.h"
+#include "prop_shop.h"
+#include "../io/utils.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+
+// ---- 终端文本提示 ----
+
+static bool text_buy_land(GameContext* ctx, int price) {
+    char input[10];
+
+    // 交互式提示需要立即显示，所以这里保留printf
+    prompt_printf(ctx, "您到达一块空地(价格: %d)，是否购买? (y/n): ", price);
+
+    while (true) {
+        if (read_prompt_input(ctx, PROMPT_BUY_LAND, input, sizeof(input)) == NULL) {
+            // 输入流结束，自动选择不购买
+            return false;
+        }
+
+        // 移除换行符
+        input[strcspn(input, "\n")] = 0;
+
+        // 检查输入是否是 y 或 n
+        if (strcmp(input, "y") == 0) {
+            return true;
+        } else if (strcmp(input, "n") == 0) {
+            return false;
+        }
+        // 输入不是 y 或 n，提示错误并循环
+        prompt_printf(ctx, "错误指令！请输入 y 或 n: "); // 交互式提示
+    }
+}
+
+static bool text_upgrade_land(GameContext* ctx, int location, int cost) {
+    int level = ctx->state.houses[location].level;
+    char input[10];
+
+    // 交互式提示
+    prompt_printf(ctx, "您的房产当前为 %d 级，可升级至 %d 级(费用: %d)，是否升级? (y/n): ", level, level + 1, cost);
+    if (read_prompt_input(ctx, PROMPT_UPGRADE_LAND, input, sizeof(input)) == NULL) {
+        return false;
+    }
+    return tolower(input[0]) == 'y';
+}
+
+static int text_choose_gift(GameContext* ctx) {
+    // 交互式提示
+    prompt_printf(ctx, "欢迎光临礼品屋，请选择一件您喜欢的礼品：\n");
+    prompt_printf(ctx, "1. 奖金 (2000元)\n");
+    prompt_printf(ctx, "2. 点数卡 (200点)\n");
+    prompt_printf(ctx, "3. 财神 (财神附身，5轮内免过路费)\n");
+    prompt_printf(ctx, "请输入礼品编号 (1-3): ");
+
+    char input[10];
+    int choice = -1;
+    if (read_prompt_input(ctx, PROMPT_GIFT, input, sizeof(input)) != NULL) {
+        sscanf(input, "%d", &choice);
+    }
+    return choice;
+}
+
+static int text_choose_prop(GameContext* ctx) {
+    char input[10];
+
+    while (true) {
+        // 交互式内容保留 printf
+        show_prop_shop_menu(ctx);
+
+        if (read_prompt_input(ctx, PROMPT_PROP_SHOP, input, sizeof(input)) == NULL) {
+            return PROP_CHOICE_END;
+        }
+
+        // 移除换行符
+        input[strcspn(input, "\n")] = 0;
+
+        // 检查是否退出 (F或f)
+        if (tolower(input[0]) == 'f') {
+            return PROP_CHOICE_EXIT;
+        }
+
+        // 尝试解析道具编号
+        int prop_id = atoi(input);
+        if (prop_id == 0 && input[0] != '0') {
+            // 交互式错误提示
+            prompt_printf(ctx, "无效输入，请输入道具编号或F退出。\n");
+            continue;
+        }
+        return prop_id;
+    }
+}
+
+// ---- 分发 ----
+
+bool decide_buy_land(GameContext* ctx, const Player* player, int location, int price) {
+    if (ctx->decisions.buy_land) {
+        return ctx->decisions.buy_land(ctx, player, location, price);
+    }
+    return text_buy_land(ctx, price);
+}
+
+bool decide_upgrade_land(GameContext* ctx, const Player* player, int location, int cost) {
+    if (ctx->decisions.upgrade_land) {
+        return ctx->decisions.upgrade_land(ctx, player, location, cost);
+    }
+    return text_upgrade_land(ctx, location, cost);
+}
+
+int decide_gift(GameContext* ctx, const Player* player) {
+    if (ctx->decisions.choose_gift) {
+        return ctx->decisions.choose_gift(ctx, player);
+    }
+    return text_choose_gift(ctx);
+}
+
+int decide_prop(GameContext* ctx, const Player* player) {
+    if (ctx->decisions.choose_prop) {
+        return ctx->decisions.choose_prop(ctx, player);
+    }
+    return text_choose_prop(ctx);
+}
+
+// ---- 脚本 ----
+
+// 取下一个答案，用完时返回 false
+static bool script_next(GameContext* ctx, int* answer) {
+    DecisionScript* script = (DecisionScript*)ctx->decisions.user_data;
+    if (script->next >= script->count) {
+        return false;
+    }
+    *answer = script->answers[script->next++];
+    return true;
+}
+
+static bool script_yes_no(GameContext* ctx, const Player* player, int location, int amount) {
+    (void)player;
+    (void)location;
+    (void)amount;
+    int answer;
+    return script_next(ctx, &answer) && answer != 0;
+}
+
+static int script_gift(GameContext* ctx, const Player* player) {
+    (void)player;
+    int answer;
+    return script_next(ctx, &answer) ? answer : -1;
+}
+
+static int script_prop(GameContext* ctx, const Player* player) {
+    (void)player;
+    int answer;
+    return script_next(ctx, &answer) ? answer : PROP_CHOICE_END;
+}
+
+void decision_use_script(GameContext* ctx, DecisionScript* script) {
+    ctx->decisions.buy_land = script_yes_no;
+    ctx->decisions.upgrade_land = script_yes_no;
+    ctx->decisions.choose_gift = script_gift;
+    ctx->decisions.choose_prop = script_prop;
+    ctx->decisions.user_data = script;
+}
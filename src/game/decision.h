@@ -0,0 +1,48 @@
+#ifndef DECISION_H
+#define DECISION_H
+
+#include "game_types.h"
+
+// 玩家决策接口：买地、升级、礼品、道具等需要玩家表态的地方都通过它询问，
+// 游戏逻辑只拿到结构化的答案，不关心答案来自终端、脚本还是程序
+// 未设置的回调使用终端文本提示（经由 read_prompt_input，因此同样适用于批处理和日志回放）
+
+struct GameContext;
+
+// 礼品屋选项，其他值按无效选择处理
+typedef enum {
+    GIFT_BONUS = 1,  // 奖金 2000 元
+    GIFT_CREDIT = 2, // 点数卡 200 点
+    GIFT_GOD = 3     // 财神附身 5 轮
+} GiftChoice;
+
+// 道具屋的特殊答案；其余值为要购买的道具编号（无效编号由道具屋拒绝）
+#define PROP_CHOICE_EXIT (-1) // 主动退出道具屋
+#define PROP_CHOICE_END  (-2) // 没有更多输入，直接离开
+
+typedef struct {
+    bool (*buy_land)(struct GameContext* ctx, const Player* player, int location, int price);
+    bool (*upgrade_land)(struct GameContext* ctx, const Player* player, int location, int cost);
+    int (*choose_gift)(struct GameContext* ctx, const Player* player);
+    int (*choose_prop)(struct GameContext* ctx, const Player* player);
+    void* user_data; // 回调私有数据
+} DecisionProvider;
+
+// 预先写好的答案序列，按询问顺序依次取用：
+// 买地、升级取非 0 为同意，礼品和道具取原值；答案用完后视为输入结束
+typedef struct {
+    const int* answers;
+    int count;
+    int next;
+} DecisionScript;
+
+// 向当前决策来源询问
+bool decide_buy_land(struct GameContext* ctx, const Player* player, int location, int price);
+bool decide_upgrade_land(struct GameContext* ctx, const Player* player, int location, int cost);
+int decide_gift(struct GameContext* ctx, const Player* player);
+int decide_prop(struct GameContext* ctx, const Player* player);
+
+// 本局改为按脚本作答，script 须在对局期间保持有效
+void decision_use_script(struct GameContext* ctx, DecisionScript* script);
+
+#endif // DECISION_H
@@ -0,0 +1,73 @@
+#include "event_log.h"
+#include <string.h>
+
+#define EVENT_LOG_MASK (EVENT_LOG_CAPACITY - 1)
+
+void event_log_init(EventLog* log) {
+    log->head = 0;
+    log->tail = 0;
+    log->dropped = 0;
+    log->verbosity = VERBOSITY_FULL;
+    log->string_used = 0;
+}
+
+void event_log_clear(EventLog* log) {
+    log->tail = log->head;
+    log->dropped = 0;
+    log->string_used = 0;
+}
+
+bool event_log_empty(const EventLog* log) {
+    return log->head == log->tail;
+}
+
+uint32_t event_log_count(const EventLog* log) {
+    return log->head - log->tail;
+}
+
+const GameEvent* event_log_at(const EventLog* log, uint32_t i) {
+    return &log->events[(log->tail + i) & EVENT_LOG_MASK];
+}
+
+const char* event_log_string(const EventLog* log, const GameEvent* event) {
+    uint32_t offset = (uint32_t)event->args[0];
+    if (offset >= EVENT_STRING_POOL_SIZE) return "";
+    return &log->strings[offset];
+}
+
+static GameEvent* event_log_reserve(EventLog* log, EventId id) {
+    if (log->head - log->tail == EVENT_LOG_CAPACITY) {
+        log->tail++;
+        log->dropped++;
+    }
+    GameEvent* event = &log->events[log->head & EVENT_LOG_MASK];
+    log->head++;
+    event->id = (uint16_t)id;
+    return event;
+}
+
+void event_log_push(EventLog* log, EventId id, int a0, int a1, int a2) {
+    GameEvent* event = event_log_reserve(log, id);
+    event->args[0] = a0;
+    event->args[1] = a1;
+    event->args[2] = a2;
+}
+
+void event_log_push_text(EventLog* log, EventId id, const char* text) {
+    // 字符串池写满时截断，池在事件全部取出后复用
+    uint32_t room = EVENT_STRING_POOL_SIZE - log->string_used;
+    uint32_t offset = EVENT_STRING_POOL_SIZE;
+    if (room > 0) {
+        size_t len = strlen(text);
+        if (len >= room) len = room - 1;
+        offset = log->string_used;
+        memcpy(&log->strings[offset], text, len);
+        log->strings[offset + len] = '\0';
+        log->string_used += (uint32_t)len + 1;
+    }
+
+    GameEvent* event = event_log_reserve(log, id);
+    event->args[0] = (int32_t)offset;
+    event->args[1] = 0;
+    event->args[2] = 0;
+}
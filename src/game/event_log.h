@@ -0,0 +1,174 @@
+#ifndef EVENT_LOG_H
+#define EVENT_LOG_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#define EVENT_LOG_CAPACITY 256      // 环形缓冲区容量（2 的幂）
+#define EVENT_MAX_ARGS 3            // 每个事件的整数参数个数
+#define EVENT_STRING_POOL_SIZE 1024 // 字符串参数池大小（文件名、命令等）
+
+// 消息详细程度
+typedef enum {
+    VERBOSITY_QUIET,    // 不记录任何事件（无头模拟、批量测试）
+    VERBOSITY_EVENTS,   // 只记录改变游戏状态的事件和命令结果
+    VERBOSITY_FULL      // 记录全部消息（交互模式默认）
+} Verbosity;
+
+// 游戏事件类型。参数含义见各项注释，“玩家”参数为玩家下标
+typedef enum {
+    EVT_NONE = 0,
+
+    // 移动
+    EVT_ROLL,                   // 玩家, 点数
+    EVT_REMOTE_DICE,            // 步数
+    EVT_MOVE_FORWARD,           // 玩家, 步数, 位置
+    EVT_MOVE_BACKWARD,          // 玩家, 步数, 位置
+    EVT_STEP_FORMAT_ERROR,
+
+    // 路障与机器娃娃
+    EVT_BLOCK_INVALID_POSITION,
+    EVT_BLOCK_SPECIAL_BUILDING,
+    EVT_BLOCK_PLAYER_PRESENT,
+    EVT_BLOCK_EXISTS,
+    EVT_BLOCK_PLACED,           // 位置
+    EVT_BLOCK_REMOVED,          // 位置
+    EVT_BLOCK_INTERCEPTED,      // 玩家, 位置
+    EVT_BLOCK_NO_PROP,
+    EVT_BLOCK_OUT_OF_MAP,
+    EVT_BLOCK_ON_SELF,
+    EVT_BLOCK_OUT_OF_RANGE,     // 范围
+    EVT_BLOCK_USED,             // 剩余路障
+    EVT_PROP_CLEARED,           // 位置
+    EVT_ROBOT_SWEEP_START,      // 范围
+    EVT_ROBOT_NOTHING_FOUND,    // 范围
+    EVT_ROBOT_SWEEP_DONE,       // 清除数量
+    EVT_ROBOT_NO_PROP,
+    EVT_ROBOT_USE,              // 玩家
+    EVT_ROBOT_USED,             // 剩余机器娃娃
+    EVT_ROBOT_WASTED,
+
+    // 土地
+    EVT_LAND_NOT_FOR_SALE,
+    EVT_LAND_OWNED_BY_SELF,
+    EVT_LAND_OWNED_BY_OTHER,
+    EVT_LAND_NO_FUND,           // 价格, 资金
+    EVT_LAND_DECLINED,
+    EVT_LAND_BOUGHT,            // 剩余资金
+    EVT_UPGRADE_MAX_LEVEL,
+    EVT_UPGRADE_NO_FUND,        // 费用, 资金
+    EVT_UPGRADED,               // 等级, 剩余资金
+    EVT_UPGRADE_DECLINED,
+    EVT_SELL_INVALID_LOCATION,
+    EVT_SELL_NOT_OWNER,
+    EVT_SOLD,                   // 售价, 资金
+    EVT_TOLL_UNOWNED,
+    EVT_TOLL_GOD_FREE,
+    EVT_TOLL_DUE,               // 地主, 等级, 过路费
+    EVT_BANKRUPT,               // 过路费, 剩余资金
+    EVT_BANKRUPT_CLEARED,       // 玩家
+    EVT_TOLL_PAID,              // 剩余资金
+    EVT_ARRIVE_PROP_SHOP,
+    EVT_ARRIVE_START,
+    EVT_ARRIVE_PARK,
+    EVT_ARRIVE_MINE,            // 获得点数, 当前点数
+    EVT_ARRIVE_SPECIAL,
+
+    // 礼品屋
+    EVT_GIFT_WELCOME,
+    EVT_GIFT_BONUS,
+    EVT_GIFT_CREDIT,
+    EVT_GIFT_GOD,
+    EVT_GIFT_INVALID,
+
+    // 道具屋
+    EVT_SHOP_NO_CREDIT,
+    EVT_SHOP_EXIT,
+    EVT_SHOP_FULL,
+
+    // 财神
+    EVT_GOD_LEFT,               // 位置
+    EVT_GOD_APPEARED,           // 位置
+    EVT_GOD_MET,                // 玩家, 位置
+    EVT_GOD_BUFF,               // 玩家, 剩余回合
+
+    // 回合与游戏
+    EVT_PLAYER_SKIPPED,         // 玩家
+    EVT_GAME_WINNER,            // 玩家
+    EVT_GAME_ALL_BANKRUPT,
+
+    // 查询（每行一个事件，数值在查询时记录）
+    EVT_QUERY_HEADER,
+    EVT_QUERY_PLAYER,           // 玩家
+    EVT_QUERY_FUND,             // 资金
+    EVT_QUERY_CREDIT,           // 点数
+    EVT_QUERY_LOCATION,         // 位置
+    EVT_QUERY_PROPS,
+    EVT_QUERY_BARRIER,          // 数量
+    EVT_QUERY_ROBOT,            // 数量
+    EVT_QUERY_STATUS,
+    EVT_QUERY_GOD_BUFF,         // 剩余回合
+    EVT_QUERY_PRISON,           // 剩余回合
+    EVT_QUERY_HOSPITAL,         // 剩余回合
+    EVT_QUERY_NO_STATUS,
+    EVT_QUERY_HOUSES,
+    EVT_QUERY_HOUSE,            // 位置, 等级
+    EVT_QUERY_NO_HOUSE,
+    EVT_QUERY_GOD_HEADER,
+    EVT_QUERY_GOD_ON_MAP,       // 位置, 剩余回合
+    EVT_QUERY_GOD_ABSENT,       // 冷却回合
+
+    // 命令
+    EVT_HELP,
+    EVT_QUIT,
+    EVT_UNKNOWN_COMMAND,        // 字符串: 原始命令
+    EVT_SELL_FORMAT_ERROR,
+    EVT_BLOCK_FORMAT_ERROR,
+    EVT_PLAYER_CREATED,         // 玩家
+    EVT_PLAYER_CREATE_FAILED,
+    EVT_CREATE_PLAYER_FORMAT_ERROR,
+    EVT_DUMP_SAVED,             // 字符串: 文件名
+    EVT_DUMP_FAILED,            // 字符串: 文件名
+    EVT_DUMP_FORMAT_ERROR,
+    EVT_LOADED,                 // 字符串: 文件名
+    EVT_LOAD_FAILED,            // 字符串: 文件名
+    EVT_LOAD_FORMAT_ERROR,
+
+    // 缓冲区
+    EVT_EVENTS_DROPPED,         // 被覆盖的事件数（不入缓冲区，输出时合成）
+
+    EVT_COUNT
+} EventId;
+
+// 一条事件：类型加整数参数，字符串参数以偏移记录在字符串池中
+typedef struct {
+    uint16_t id;
+    int32_t args[EVENT_MAX_ARGS];
+} GameEvent;
+
+// 事件环形缓冲区：写满时覆盖最旧的事件，并记下覆盖的条数供输出时提示
+typedef struct {
+    GameEvent events[EVENT_LOG_CAPACITY];
+    uint32_t head;      // 已写入事件总数
+    uint32_t tail;      // 第一个未取出事件的序号
+    uint32_t dropped;   // 上次清空后因缓冲区写满而被覆盖的事件数
+    Verbosity verbosity; // 记录哪些事件，由消息目录中的级别决定
+    uint32_t string_used;
+    char strings[EVENT_STRING_POOL_SIZE];
+} EventLog;
+
+void event_log_init(EventLog* log);
+void event_log_clear(EventLog* log);
+bool event_log_empty(const EventLog* log);
+uint32_t event_log_count(const EventLog* log);
+
+// 按顺序取第 i 个未取出的事件（0 为最旧）
+const GameEvent* event_log_at(const EventLog* log, uint32_t i);
+
+// 取事件的字符串参数
+const char* event_log_string(const EventLog* log, const GameEvent* event);
+
+void event_log_push(EventLog* log, EventId id, int a0, int a1, int a2);
+void event_log_push_text(EventLog* log, EventId id, const char* text);
+
+#endif // EVENT_LOG_H
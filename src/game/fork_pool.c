@@ -0,0 +1,96 @@
+#include "fork_pool.h"
+#include <stdlib.h>
+#include <string.h>
+
+static void copy_tile_set(TileSet* dst, const TileSet* src, int words) {
+    memcpy(dst->words, src->words, (size_t)words * sizeof(src->words[0]));
+}
+
+// 需要复制的房产索引数：覆盖所有玩家的 index（通常就是玩家数）
+static int holdings_in_use(const GameState* state) {
+    int count = state->player_count;
+    for (int i = 0; i < state->player_count; i++) {
+        int index = state->players[i].index;
+        if (index >= count && index < MAX_PLAYERS) {
+            count = index + 1;
+        }
+    }
+    return count;
+}
+
+void game_clone(GameContext* dst, const GameContext* src) {
+    const GameState* from = &src->state;
+    GameState* to = &dst->state;
+    size_t size = (size_t)src->board->size;
+    int words = (int)((size + 63) / 64);
+
+    to->player_count = from->player_count;
+    memcpy(to->players, from->players, (size_t)from->player_count * sizeof(from->players[0]));
+    memcpy(to->houses, from->houses, size * sizeof(from->houses[0]));
+    int holdings = holdings_in_use(from);
+    for (int i = 0; i < holdings; i++) {
+        const Holdings* h = &from->holdings[i];
+        copy_tile_set(&to->holdings[i].tiles, &h->tiles, words);
+        to->holdings[i].count = h->count;
+        to->holdings[i].investment = h->investment;
+        memcpy(to->holdings[i].district_count, h->district_count, sizeof(h->district_count));
+    }
+    memcpy(to->occupancy.players, from->occupancy.players, size);
+    memcpy(to->occupancy.alive, from->occupancy.alive, size);
+    copy_tile_set(&to->placed_prop.bomb, &from->placed_prop.bomb, words);
+    copy_tile_set(&to->placed_prop.barrier, &from->placed_prop.barrier, words);
+    to->god = from->god;
+    to->game = from->game;
+
+    dst->board = src->board;
+    dst->rng = src->rng;
+    dst->decisions = src->decisions;
+    dst->io = src->io;
+    dst->io.journal = NULL;
+    dst->quit_requested = src->quit_requested;
+    event_log_init(&dst->events);
+    dst->events.verbosity = src->events.verbosity;
+}
+
+int fork_pool_init(ForkPool* pool, int capacity) {
+    memset(pool, 0, sizeof(*pool));
+    if (capacity <= 0) {
+        return -1;
+    }
+    pool->slots = (GameContext*)calloc((size_t)capacity, sizeof(GameContext));
+    pool->free_slots = (int*)malloc((size_t)capacity * sizeof(int));
+    if (!pool->slots || !pool->free_slots) {
+        fork_pool_destroy(pool);
+        return -1;
+    }
+    pool->capacity = capacity;
+    fork_pool_reset(pool);
+    return 0;
+}
+
+void fork_pool_destroy(ForkPool* pool) {
+    free(pool->slots);
+    free(pool->free_slots);
+    memset(pool, 0, sizeof(*pool));
+}
+
+GameContext* fork_pool_acquire(ForkPool* pool, const GameContext* parent) {
+    if (pool->free_count == 0) {
+        return NULL;
+    }
+    GameContext* child = &pool->slots[pool->free_slots[--pool->free_count]];
+    game_clone(child, parent);
+    return child;
+}
+
+void fork_pool_release(ForkPool* pool, GameContext* child) {
+    pool->free_slots[pool->free_count++] = (int)(child - pool->slots);
+}
+
+void fork_pool_reset(ForkPool* pool) {
+    // 倒序入栈，先取出的是 0 号槽位
+    for (int i = 0; i < pool->capacity; i++) {
+        pool->free_slots[i] = pool->capacity - 1 - i;
+    }
+    pool->free_count = pool->capacity;
+}
@@ -0,0 +1,37 @@
+#ifndef FORK_POOL_H
+#define FORK_POOL_H
+
+#include "game_types.h"
+#include "game_context.h"
+
+// 对局分叉：从某一局面复制出独立的子对局，用于搜索型 AI 和“如果……会怎样”的分析
+// 状态数组按容量定长，复制时只拷贝地图格子数和玩家数覆盖的部分，一次分叉只有几 KB
+
+// 把 src 的局面复制到 dst：对局状态、地图、随机数、决策来源和输入输出钩子
+// dst 的事件记录清空（保留 src 的详细程度），不继承命令日志
+// 子对局通常需要预先设置 decisions，否则落地后的决策会回到终端提示
+// GameState 增加字段时须同步修改这里
+void game_clone(GameContext* dst, const GameContext* src);
+
+// 预先分配的子对局槽位，分叉和回收都不再分配内存；不是线程安全的，每个线程使用自己的池
+typedef struct {
+    GameContext* slots;
+    int* free_slots;  // 空闲槽位下标的栈
+    int free_count;
+    int capacity;
+} ForkPool;
+
+// 分配 capacity 个槽位，成功返回 0
+int fork_pool_init(ForkPool* pool, int capacity);
+void fork_pool_destroy(ForkPool* pool);
+
+// 取一个空闲槽位并复制 parent 的局面，槽位用完时返回 NULL
+GameContext* fork_pool_acquire(ForkPool* pool, const GameContext* parent);
+
+// 归还 fork_pool_acquire 取得的槽位
+void fork_pool_release(ForkPool* pool, GameContext* child);
+
+// 归还全部槽位
+void fork_pool_reset(ForkPool* pool);
+
+#endif // FORK_POOL_H
@@ -0,0 +1,54 @@
+#include "game_context.h"
+#include "game_state.h"
+#include "message_catalog.h"
+#include <string.h>
+
+void game_context_init(GameContext* ctx, uint64_t seed, uint64_t stream) {
+    memset(ctx, 0, sizeof(*ctx));
+    rng_init(&ctx->rng, seed, stream);
+    event_log_init(&ctx->events);
+    ctx->io.read_prompt = NULL;
+    ctx->io.echo_prompts = true;
+    ctx->io.user_data = NULL;
+    ctx->io.journal = NULL;
+    ctx->io.dump.save = NULL;
+    ctx->io.dump.user_data = NULL;
+    ctx->io.dump.style = JSON_STYLE_PRETTY;
+    ctx->board = board_active();
+    init_game_state(ctx);
+}
+
+// 本局随机数，返回 [0, bound)
+int game_rand_below(GameContext* ctx, int bound) {
+    return (int)rng_below(&ctx->rng, (uint32_t)bound);
+}
+
+// 当前详细程度是否需要记录该事件，不需要时不做任何工作
+static inline bool event_wanted(const GameContext* ctx, EventId id) {
+    return ctx->events.verbosity >= message_template(id)->level;
+}
+
+void emit_event(GameContext* ctx, EventId id) {
+    if (!event_wanted(ctx, id)) return;
+    event_log_push(&ctx->events, id, 0, 0, 0);
+}
+
+void emit_event1(GameContext* ctx, EventId id, int a0) {
+    if (!event_wanted(ctx, id)) return;
+    event_log_push(&ctx->events, id, a0, 0, 0);
+}
+
+void emit_event2(GameContext* ctx, EventId id, int a0, int a1) {
+    if (!event_wanted(ctx, id)) return;
+    event_log_push(&ctx->events, id, a0, a1, 0);
+}
+
+void emit_event3(GameContext* ctx, EventId id, int a0, int a1, int a2) {
+    if (!event_wanted(ctx, id)) return;
+    event_log_push(&ctx->events, id, a0, a1, a2);
+}
+
+void emit_event_text(GameContext* ctx, EventId id, const char* text) {
+    if (!event_wanted(ctx, id)) return;
+    event_log_push_text(&ctx->events, id, text);
+}
@@ -0,0 +1,69 @@
+#ifndef GAME_CONTEXT_H
+#define GAME_CONTEXT_H
+
+#include "game_types.h"
+#include "event_log.h"
+#include "board.h"
+#include "decision.h"
+#include "../utils/rng.h"
+#include "../utils/json_writer.h"
+
+// 交互提示类型，无头模式下用于区分需要自动应答的问题
+typedef enum {
+    PROMPT_BUY_LAND,      // 是否购买空地 (y/n)
+    PROMPT_UPGRADE_LAND,  // 是否升级房产 (y/n)
+    PROMPT_GIFT,          // 礼品屋选择 (1-3)
+    PROMPT_PROP_SHOP,     // 道具屋选择 (道具编号或F)
+    PROMPT_INITIAL_FUND,  // 开局初始资金（空行为默认值）
+    PROMPT_CHARACTERS     // 开局角色编号（如 1234）
+} PromptKind;
+
+struct GameContext;
+struct Journal;
+
+// 交互输入钩子：与 fgets 语义一致，返回 NULL 表示输入结束
+typedef char* (*PromptInputHook)(struct GameContext* ctx, PromptKind kind, char* buffer, int size);
+
+// 存档钩子：dump 命令通过它保存状态，返回 0 表示成功
+typedef struct {
+    int (*save)(const struct GameContext* ctx, const char* filename, void* user_data);
+    void* user_data;
+    JsonStyle style;    // save 为 NULL 时写入文件所用的格式
+} DumpSink;
+
+// 本局的输入输出钩子
+typedef struct {
+    PromptInputHook read_prompt; // 交互输入，NULL 时读取标准输入
+    bool echo_prompts;           // 是否输出交互提示
+    void* user_data;             // 钩子私有数据
+    struct Journal* journal;     // 命令日志，NULL 时不记录
+    DumpSink dump;               // dump 命令的存档去向，save 为 NULL 时写入文件
+} GameIoHooks;
+
+// 游戏上下文：一局游戏的全部可变状态，各局之间互不共享
+typedef struct GameContext {
+    GameState state;                   // 游戏状态
+    const Board* board;                // 本局使用的地图（只读，各局共享）
+    EventLog events;                   // 待显示的游戏事件
+    Rng rng;                           // 本局随机数发生器
+    GameIoHooks io;                    // 输入输出钩子
+    DecisionProvider decisions;        // 玩家决策来源，未设置的回调使用终端文本提示
+    bool quit_requested;               // 玩家输入了 quit，由驱动循环负责退出
+} GameContext;
+
+void game_context_init(GameContext* ctx, uint64_t seed, uint64_t stream);
+int game_rand_below(GameContext* ctx, int bound);
+
+// 玩家在 players 数组中的下标（事件中以此引用玩家）
+static inline int player_slot(const GameContext* ctx, const Player* player) {
+    return (int)(player - ctx->state.players);
+}
+
+// 记录游戏事件，文本由前端在显示时再生成
+void emit_event(GameContext* ctx, EventId id);
+void emit_event1(GameContext* ctx, EventId id, int a0);
+void emit_event2(GameContext* ctx, EventId id, int a0, int a1);
+void emit_event3(GameContext* ctx, EventId id, int a0, int a1, int a2);
+void emit_event_text(GameContext* ctx, EventId id, const char* text);
+
+#endif // GAME_CONTEXT_H
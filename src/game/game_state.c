@@ -1,67 +1,70 @@
 #include "game_state.h"
+#include "tile_set.h"
+#include "ownership.h"
+#include "occupancy.h"
+#include "../io/output.h"
 #include <stdio.h>
 #include <string.h>
 
-// 全局游戏状态定义
-GameState g_game_state;
+// 地图上该地段的默认地价，地段无效时返回 0
+int get_district_price(const Board* board, int district) {
+    if (district < 0 || district > DISTRICT_COUNT) {
+        return 0;
+    }
+    return board->district_price[district];
+}
 
-void init_game_state(void) {
-    g_game_state.player_count = 0;
-    g_game_state.game.started = false;
-    g_game_state.game.ended = false;
-    g_game_state.game.now_player_id = 0;
-    g_game_state.game.last_player_id = 0;
-    g_game_state.game.pending_interaction_player_id = 0;
+void init_game_state(GameContext* ctx) {
+    ctx->state.player_count = 0;
+    ctx->state.game.started = false;
+    ctx->state.game.ended = false;
+    ctx->state.game.now_player_id = 0;
+    ctx->state.game.last_player_id = 0;
+    ctx->state.game.pending_interaction_player_id = 0;
 
     // 初始化房产
-    for (int i = 0; i < MAP_SIZE; i++) {
-        g_game_state.houses[i].id = i;
-        g_game_state.houses[i].level = 0;
-        g_game_state.houses[i].owner_id = -1; // 无人拥有
+    for (int i = 0; i < ctx->board->size; i++) {
+        ctx->state.houses[i].id = i;
+        ctx->state.houses[i].level = 0;
+        ctx->state.houses[i].owner_id = -1; // 无人拥有
         
-        // 根据位置设置价格
-        if ((i >= 1 && i <= 13) || (i >= 15 && i <= 27)) { // 地段1
-            g_game_state.houses[i].price = 200;
-        } else if ((i >= 29 && i <= 34)) { // 地段2
-            g_game_state.houses[i].price = 500;
-        } else if ((i >= 36 && i <= 48) || (i >= 50 && i <= 62)) { // 地段3
-            g_game_state.houses[i].price = 300;
-        } else {
-            g_game_state.houses[i].price = 0; // 特殊位置不可购买
-        }
+        // 地价由地图给出，特殊位置价格为 0 不可购买
+        ctx->state.houses[i].price = ctx->board->tiles[i].price;
     }
+    ownership_rebuild(ctx);
+    occupancy_rebuild(ctx);
     
     // 初始化道具
-    memset(g_game_state.placed_prop.bomb, 0, sizeof(g_game_state.placed_prop.bomb));
-    memset(g_game_state.placed_prop.barrier, 0, sizeof(g_game_state.placed_prop.barrier));
+    tile_set_clear_all(&ctx->state.placed_prop.bomb);
+    tile_set_clear_all(&ctx->state.placed_prop.barrier);
     
     // 初始化财神状态
-    g_game_state.god.spawn_cooldown = 10;
-    g_game_state.god.location = -1;
-    g_game_state.god.duration = 0;
+    ctx->state.god.spawn_cooldown = 10;
+    ctx->state.god.location = -1;
+    ctx->state.god.duration = 0;
 
     // 初始化游戏信息
-    g_game_state.game.now_player_id = 0;
-    g_game_state.game.next_player_id = 1;
-    g_game_state.game.ended = false;
-    g_game_state.game.winner_id = -1;
+    ctx->state.game.now_player_id = 0;
+    ctx->state.game.next_player_id = 1;
+    ctx->state.game.ended = false;
+    ctx->state.game.winner_id = -1;
 }
 
-void print_game_state(void) {
-    printf("=== 游戏状态 ===\n");
-    printf("玩家数量: %d\n", g_game_state.player_count);
+void print_game_state(GameContext* ctx) {
+    output_printf("=== 游戏状态 ===\n");
+    output_printf("玩家数量: %d\n", ctx->state.player_count);
     
-    for (int i = 0; i < g_game_state.player_count; i++) {
-        Player* p = &g_game_state.players[i];
-        printf("玩家%d: %s, 资金:%d, 位置:%d, 存活:%s\n", 
+    for (int i = 0; i < ctx->state.player_count; i++) {
+        Player* p = &ctx->state.players[i];
+        output_printf("玩家%d: %s, 资金:%d, 位置:%d, 存活:%s\n", 
                p->index, p->name, p->fund, p->location, 
                p->alive ? "是" : "否");
     }
     
-    printf("当前玩家: %d\n", g_game_state.game.now_player_id);
-    printf("游戏结束: %s\n", g_game_state.game.ended ? "是" : "否");
+    output_printf("当前玩家: %d\n", ctx->state.game.now_player_id);
+    output_printf("游戏结束: %s\n", ctx->state.game.ended ? "是" : "否");
 }
 
-GameState* get_game_state(void) {
-    return &g_game_state;
+GameState* get_game_state(GameContext* ctx) {
+    return &ctx->state;
 }
\ No newline at end of file
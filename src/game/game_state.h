@@ -2,13 +2,12 @@
 #define GAME_STATE_H
 
 #include "game_types.h"
-
-// 全局游戏状态声明
-extern GameState g_game_state;
+#include "game_context.h"
 
 // 游戏状态管理函数声明
-void init_game_state(void);
-void print_game_state(void);
-GameState* get_game_state(void);
+void init_game_state(GameContext* ctx);
+void print_game_state(GameContext* ctx);
+GameState* get_game_state(GameContext* ctx);
+int get_district_price(const Board* board, int district);
 
 #endif // GAME_STATE_H
\ No newline at end of file
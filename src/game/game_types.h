@@ -2,11 +2,13 @@
 #define GAME_TYPES_H
 
 #include <stdbool.h>
+#include <stdint.h>
 
-#define MAX_PLAYERS 4
-#define MAP_SIZE 70
+#define MAX_PLAYERS 64 // 玩家数上限，实际玩家数为 player_count
+#define MAX_MAP_SIZE 4096 // 地图格子数上限，实际格子数由所用地图决定（见 board.h）
 #define MAX_PROPS 10
 #define MAX_NAME_LENGTH 32
+#define DISTRICT_COUNT 3 // 地段数上限
 
 // 角色信息结构
 typedef struct {
@@ -59,12 +61,34 @@ typedef struct {
     int duration;       // 存续时间，从 5 开始递减
 } God;
 
-// 放置的道具结构
+// 按格子编号的位集：每格 1 位，第 i 格在 words[i / 64] 的第 i % 64 位
+#define TILE_SET_WORDS ((MAX_MAP_SIZE + 63) / 64)
+
+typedef struct {
+    uint64_t words[TILE_SET_WORDS];
+} TileSet;
+
+// 放置的道具结构（操作见 tile_set.h）
 typedef struct {
-    int bomb[MAP_SIZE];    // 炸弹位置列表, 1表示有
-    int barrier[MAP_SIZE]; // 路障位置列表, 1表示有
+    TileSet bomb;    // 炸弹所在格子
+    TileSet barrier; // 路障所在格子
 } PlacedProp;
 
+// 单个玩家的房产索引与汇总（由 ownership.c 维护，与 houses[].owner_id 保持一致）
+typedef struct {
+    TileSet tiles;                           // 拥有的地块
+    int count;                               // 地块数
+    int investment;                          // 总投资：各地块 price * (1 + level) 之和
+    int district_count[DISTRICT_COUNT + 1];  // 各地段的地块数，下标为地段编号
+} Holdings;
+
+// 每格上的玩家数（由 occupancy.c 维护，与 players[].location / alive 保持一致）
+// 计数用 uint8_t，MAX_PLAYERS 不能超过 255
+typedef struct {
+    uint8_t players[MAX_MAP_SIZE]; // 该格上的玩家数（含已破产的玩家）
+    uint8_t alive[MAX_MAP_SIZE];   // 其中未破产的玩家数
+} Occupancy;
+
 // 游戏核心状态结构
 typedef struct {
     int now_player_id; // 当前操作玩家
@@ -81,7 +105,9 @@ typedef struct {
 typedef struct {
     Player players[MAX_PLAYERS];
     int player_count;
-    House houses[MAP_SIZE];
+    House houses[MAX_MAP_SIZE]; // 只使用前 board->size 个
+    Holdings holdings[MAX_PLAYERS]; // 按 owner_id 索引的房产归属
+    Occupancy occupancy;            // 按位置索引的玩家分布
     PlacedProp placed_prop;
     God god;            // 地图上随机生成的财神道具
     Game game;
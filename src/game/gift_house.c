@@ -1,46 +1,29 @@
 #include "gift_house.h"
-#include "../io/command_processor.h" // 包含 g_last_action_message
-#include <stdio.h>
-#include <string.h>
+#include "decision.h"
 
-void enter_gift_house(Player* player) {
-    char message_buffer[256];
-    
-    snprintf(message_buffer, sizeof(message_buffer), "欢迎光临礼品屋，请选择一件您喜欢的礼品：\n1. 奖金 (2000元)\n2. 点数卡 (200点)\n3. 财神 (财神附身，5轮内免过路费)\n");
-    strncat(g_last_action_message, message_buffer, sizeof(g_last_action_message) - strlen(g_last_action_message) - 1);
+void enter_gift_house(GameContext* ctx, Player* player) {
+    emit_event(ctx, EVT_GIFT_WELCOME);
 
-    // 交互式提示
-    printf("欢迎光临礼品屋，请选择一件您喜欢的礼品：\n");
-    printf("1. 奖金 (2000元)\n");
-    printf("2. 点数卡 (200点)\n");
-    printf("3. 财神 (财神附身，5轮内免过路费)\n");
-    printf("请输入礼品编号 (1-3): ");
-
-    char input[10];
-    fgets(input, sizeof(input), stdin);
-
-    int choice = -1;
-    sscanf(input, "%d", &choice);
+    int choice = decide_gift(ctx, player);
 
     // 清空之前的欢迎消息，准备写入结果消息
-    g_last_action_message[0] = '\0';
+    event_log_clear(&ctx->events);
 
     switch (choice) {
-        case 1:
+        case GIFT_BONUS:
             player->fund += 2000;
-            snprintf(message_buffer, sizeof(message_buffer), "您获得了 2000 元奖金！\n");
+            emit_event(ctx, EVT_GIFT_BONUS);
             break;
-        case 2:
+        case GIFT_CREDIT:
             player->credit += 200;
-            snprintf(message_buffer, sizeof(message_buffer), "您获得了 200 点数！\n");
+            emit_event(ctx, EVT_GIFT_CREDIT);
             break;
-        case 3:
+        case GIFT_GOD:
             player->buff.god += 5;
-            snprintf(message_buffer, sizeof(message_buffer), "财神已附身！5轮内免过路费。\n");
+            emit_event(ctx, EVT_GIFT_GOD);
             break;
         default:
-            snprintf(message_buffer, sizeof(message_buffer), "无效的选择，您放弃了这次机会。\n");
+            emit_event(ctx, EVT_GIFT_INVALID);
             break;
     }
-    strncat(g_last_action_message, message_buffer, sizeof(g_last_action_message) - strlen(g_last_action_message) - 1);
 }
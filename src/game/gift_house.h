@@ -3,6 +3,6 @@
 
 #include "player.h"
 
-void enter_gift_house(Player* player);
+void enter_gift_house(GameContext* ctx, Player* player);
 
 #endif // GIFT_HOUSE_H
@@ -2,11 +2,12 @@
 #define GOD_SYSTEM_H
 
 #include "game_types.h"
+#include "game_context.h"
 
-void update_god_status();
+void update_god_status(GameContext* ctx);
 // 检查指定位置是否有财神
-bool check_god_encounter(int location);
+bool check_god_encounter(GameContext* ctx, int location);
 // 触发财神效果
-void trigger_god_encounter(Player* player, int location);
+void trigger_god_encounter(GameContext* ctx, Player* player, int location);
 
 #endif // GOD_SYSTEM_H
@@ -2,9 +2,10 @@
 #define LAND_H
 
 #include "../game/game_types.h"
+#include "../game/game_context.h"
 
-void on_player_land(Player* player);
-void handle_sell_command(int location);
-void check_win_condition();
+void on_player_land(GameContext* ctx, Player* player);
+void handle_sell_command(GameContext* ctx, int location);
+void check_win_condition(GameContext* ctx);
 
-#endif // LAND_H
+#endif // LAND_H
\ No newline at end of file
@@ -6,172 +6,95 @@
 #include <stdio.h>
 #include <string.h>
 
-void display_map() {
-    char map[8][30]; // Increased size for null terminator
-    // Initialize map with spaces
-    for (int i = 0; i < 8; i++) {
-        for (int j = 0; j < 29; j++) {
-            map[i][j] = ' ';
-        }
-        map[i][29] = '\0';
-    }
-
-    // Static map elements
-    map[0][0] = 'S';
-    for (int i = 1; i <= 13; i++) map[0][i] = '0';
-    map[0][14] = 'P';
-    for (int i = 15; i <= 27; i++) map[0][i] = '0';
-    map[0][28] = 'T';
-
-    for (int i = 1; i <= 6; i++) map[i][28] = '0';
-
-    map[7][28] = 'G';
-    for (int i = 27; i >= 15; i--) map[7][i] = '0';
-    map[7][14] = 'P';
-    for (int i = 13; i >= 1; i--) map[7][i] = '0';
-    map[7][0] = 'P';
-
-    for (int i = 1; i <= 6; i++) map[i][0] = '$';
-
-
-    
-    // Place God
-    if (g_game_state.god.location != -1) {
-        int loc = g_game_state.god.location;
-        if (loc >= 0 && loc <= 28) { map[0][loc] = 'F'; }
-        else if (loc >= 29 && loc <= 35) { map[loc - 28][28] = 'F'; }
-        else if (loc >= 36 && loc <= 63) { map[7][28 - (loc - 35)] = 'F'; }
-        else if (loc >= 64 && loc <= 69) { map[7 - (loc - 63)][0] = 'F'; }
-    }
-
-    // Place players
-    for (int i = 0; i < g_game_state.player_count; i++) {
-        Player* p = &g_game_state.players[i];
-        if (!p->alive) continue;
-
-        int loc = p->location;
-        char symbol = p->name[0];
+int map_cell_of_location(const Board* board, int location) {
+    if (!board_contains(board, location) || board->rows == 0) return -1;
+    return board->tile_cell[location];
+}
 
-        if (loc >= 0 && loc <= 28) { // Top row (S...H...T)
-            map[0][loc] = symbol;
-        } else if (loc >= 29 && loc <= 35) { // Right column (T...G)
-            map[loc - 28][28] = symbol;
-        } else if (loc >= 36 && loc <= 63) { // Bottom row (G...P...M)
-            map[7][28 - (loc - 35)] = symbol;
-        } else if (loc >= 64 && loc <= 69) { // Left column (M...S)
-            map[7 - (loc - 63)][0] = symbol;
+void build_map_cells(GameContext* ctx, MapCell cells[BOARD_MAX_CELLS]) {
+    const Board* board = ctx->board;
+    GameState* state = &ctx->state;
+    int cell_count = board->rows * board->cols;
+    if (cell_count == 0) return;
+
+    // 财神覆盖其所在格子的静态字符
+    int god_cell = map_cell_of_location(board, state->god.location);
+
+    // 按位置建立占用索引：同一位置优先显示上一个行动的玩家，否则显示编号最大的玩家
+    int occupant[MAX_MAP_SIZE];
+    for (int loc = 0; loc < board->size; loc++) occupant[loc] = -1;
+    if (state->player_count > 0) {
+        int last_moved_player_id = (state->game.now_player_id + state->player_count - 1) % state->player_count;
+        for (int k = 0; k < state->player_count; k++) {
+            Player* p = &state->players[k];
+            if (!p->alive || !board_contains(board, p->location)) continue;
+            if (occupant[p->location] != last_moved_player_id) {
+                occupant[p->location] = k;
+            }
         }
     }
 
-    // Print map with annotations
-    for (int i = 0; i < 8; i++) {
-        if (i == 0) {
-            printf("            地段 1\n");
+    for (int cell = 0; cell < cell_count; cell++) {
+        MapCell* out = &cells[cell];
+        out->color = NULL;
+        char base = (cell == god_cell) ? 'F' : board->cell_base[cell];
+
+        int occupant_loc = board->cell_occupant[cell];
+        int k = (occupant_loc != -1) ? occupant[occupant_loc] : -1;
+        if (k != -1) {
+            Player* p = &state->players[k];
+            out->symbol = p->name[0];
+            out->color = p->color;
+            continue;
         }
-        
-        for (int j = 0; j < 29; j++) {
-            Player* top_player = NULL;
-            int last_moved_player_id = (g_game_state.game.now_player_id + g_game_state.player_count - 1) % g_game_state.player_count;
-
-            for (int k = 0; k < g_game_state.player_count; k++) {
-                Player* p = &g_game_state.players[k];
-                if (p->alive) {
-                    int loc = p->location;
-                    int map_i = -1, map_j = -1;
-
-                    if (loc >= 0 && loc <= 28) { map_i = 0; map_j = loc; } 
-                    else if (loc >= 29 && loc <= 35) { map_i = loc - 28; map_j = 28; } 
-                    else if (loc >= 36 && loc <= 63) { map_i = 7; map_j = 28 - (loc - 35); } 
-                    else if (loc >= 64 && loc <= 69) { map_i = 7 - (loc - 63); map_j = 0; }
-
-                    if (i == map_i && j == map_j) {
-                        if (top_player == NULL || k == last_moved_player_id) {
-                            top_player = p;
-                        }
-                    }
-                }
-            }
-
-            if (top_player) {
-                // If the top player is the last one who moved, display them.
-                // Otherwise, we need to find the last moved player if they are on this spot.
-                Player* player_to_show = NULL;
-                bool last_moved_player_on_spot = false;
-                (void)last_moved_player_on_spot; // 避免未使用变量警告
-                 for (int k = 0; k < g_game_state.player_count; k++) {
-                    Player* p = &g_game_state.players[k];
-                     if (p->alive) {
-                        int loc = p->location;
-                        int map_i = -1, map_j = -1;
-                        if (loc >= 0 && loc <= 28) { map_i = 0; map_j = loc; } 
-                        else if (loc >= 29 && loc <= 35) { map_i = loc - 28; map_j = 28; } 
-                        else if (loc >= 36 && loc <= 63) { map_i = 7; map_j = 28 - (loc - 35); } 
-                        else if (loc >= 64 && loc <= 69) { map_i = 7 - (loc - 63); map_j = 0; }
-
-                        if (i == map_i && j == map_j) {
-                            if (k == last_moved_player_id) {
-                                player_to_show = p;
-                                last_moved_player_on_spot = true;
-                                break;
-                            }
-                            player_to_show = p; // default to last player in array if last moved is not here
-                        }
-                    }
-                }
 
+        int loc = board->cell_tile[cell];
+        if (loc != -1 && has_block_at_location(ctx, loc)) {
+            out->symbol = BLOCK_SYMBOL;  // 显示路障符号 #
+        } else if (loc != -1 && state->houses[loc].owner_id != -1) {
+            int level = state->houses[loc].level;
+            out->symbol = (level > 0 && level <= 3) ? level + '0' : base;
+            out->color = state->players[state->houses[loc].owner_id].color;
+        } else {
+            out->symbol = base;
+        }
+    }
+}
 
-                if (player_to_show) {
-                     printf("%s%c%s", player_to_show->color, player_to_show->name[0], COLOR_RESET);
-                } else {
-                    printf("%c", map[i][j]);
-                }
-            } else {
-                int loc = -1;
-                if (i == 0) loc = j;
-                else if (i == 7) {
-                    if (j <= 13) loc = 63 - j;
-                    else if (j == 14) loc = 49; // P
-                    else if (j >= 15) loc = 36 + (28-j);
-                }
-                else if (j == 0 && i > 0 && i < 7) loc = 69 - (i-1);
-                else if (j == 28 && i > 0 && i < 7) loc = 28 + i;
+void map_cell_append(FrameBuffer* fb, const MapCell* cell, const char* reset) {
+    if (cell->color) {
+        frame_puts(fb, cell->color);
+        frame_putc(fb, cell->symbol);
+        frame_puts(fb, reset);
+    } else {
+        frame_putc(fb, cell->symbol);
+    }
+}
 
-                // 检查是否有路障
-                if (loc != -1 && has_block_at_location(loc)) {
-                    printf("%c", BLOCK_SYMBOL);  // 显示路障符号 #
-                } else if (loc != -1 && g_game_state.houses[loc].owner_id != -1) {
-                    Player* owner = &g_game_state.players[g_game_state.houses[loc].owner_id];
-                    int level = g_game_state.houses[loc].level;
-                    char symbol = (level > 0 && level <= 3) ? level + '0' : map[i][j];
-                    printf("%s%c%s", owner->color, symbol, COLOR_RESET);
-                } else {
-                    printf("%c", map[i][j]);
-                }
-            }
-        }
+void compose_map_frame(const Board* board, const MapCell cells[BOARD_MAX_CELLS], FrameBuffer* fb) {
+    const char* reset = COLOR_RESET;
 
-        if (i == 3) {
-            printf("    地段 2");
+    frame_puts(fb, board->header);
+    frame_putc(fb, '\n');
+    for (int i = 0; i < board->rows; i++) {
+        for (int j = 0; j < board->cols; j++) {
+            map_cell_append(fb, &cells[i * board->cols + j], reset);
         }
-        printf("\n");
-        if (i == 7) {
-            printf("            地段 3\n");
+        if (i == board->side_label_row) {
+            frame_puts(fb, board->side_label);
         }
+        frame_putc(fb, '\n');
     }
+    frame_puts(fb, board->footer);
+    frame_putc(fb, '\n');
 }
 
-char get_map_symbol(int location) {
-    if (location == 0) return 'S';
-    if (location >= 1 && location <= 13) return '0';
-    if (location == 14) return 'P';
-    if (location >= 15 && location <= 27) return '0';
-    if (location == 28) return 'T';
-    if (location >= 29 && location <= 35) return '0';
-    if (location == 36) return 'G';
-    if (location >= 37 && location <= 48) return '0';
-    if (location == 49) return 'P';
-    if (location >= 50 && location <= 62) return '0';
-    if (location == 63) return 'P';
-    if (location >= 64 && location <= 69) return '$';
-    return ' '; //
-} //Invalid location
+void display_map(GameContext* ctx) {
+    MapCell cells[BOARD_MAX_CELLS];
+    FrameBuffer fb;
+
+    build_map_cells(ctx, cells);
+    frame_init(&fb);
+    compose_map_frame(ctx->board, cells, &fb);
+    frame_flush(&fb);
+}
@@ -2,8 +2,32 @@
 #define MAP_H
 
 #include "game_types.h"
+#include "game_context.h"
+#include "../io/frame_buffer.h"
 
-void display_map();
-char get_map_symbol(int location);
+// 整帧共 board->rows + 2 行：首行为上方标注（经典地图为“地段 1”），末行为下方标注
+static inline int map_frame_lines(const Board* board) {
+    return board->rows + 2;
+}
+
+// 一个显示格子：字符及其颜色（color 为 NULL 表示不着色）
+typedef struct {
+    char symbol;
+    const char* color;
+} MapCell;
+
+void display_map(GameContext* ctx);
+
+// 位置 -> 显示格子（行*cols+列），无效或不显示的位置返回 -1
+int map_cell_of_location(const Board* board, int location);
+
+// 计算当前状态下每个格子的显示内容（共 rows * cols 个）
+void build_map_cells(GameContext* ctx, MapCell cells[BOARD_MAX_CELLS]);
+
+// 输出单个格子（着色格子后跟 reset）
+void map_cell_append(FrameBuffer* fb, const MapCell* cell, const char* reset);
+
+// 将整帧地图（含地段标注）写入缓冲区，与 display_map 的输出一致
+void compose_map_frame(const Board* board, const MapCell cells[BOARD_MAX_CELLS], FrameBuffer* fb);
 
 #endif // MAP_H
@@ -0,0 +1,162 @@
+#include "message_catalog.h"
+#include <string.h>
+
+// 命令帮助全文
+#define HELP_TEXT \
+    "命令帮助:\n" \
+    "roll\n" \
+    "  掷骰子命令，行走1～6步，步数由随机算法产生。\n" \
+    "sell n\n" \
+    "  出售房产，n为房产在地图上的绝对位置，出售价格为投资总成本的2倍。\n" \
+    "block n\n" \
+    "  放置路障，n为前后相对距离（±10步），玩家经过将被拦截。\n" \
+    "robot\n" \
+    "  清扫前方10步内的障碍（路障）。\n" \
+    "query\n" \
+    "  显示自家资产信息。\n" \
+    "help\n" \
+    "  查看命令帮助。\n" \
+    "quit\n" \
+    "  强制退出游戏。\n" \
+    "step n\n" \
+    "  遥控骰子，指定行走步数。\n"
+
+// 消息模板表，按事件类型下标
+// 占位符依次消耗事件参数：%d 整数，%p 玩家名（参数为玩家下标），%s 字符串参数
+static const MessageTemplate s_catalog[EVT_COUNT] = {
+    [EVT_NONE] = { "", VERBOSITY_FULL },
+
+    // 移动
+    [EVT_ROLL] = { "玩家 %p 掷骰子，点数为 %d\n", VERBOSITY_EVENTS },
+    [EVT_REMOTE_DICE] = { "遥控骰子，指定步数为 %d\n", VERBOSITY_FULL },
+    [EVT_MOVE_FORWARD] = { "%p 前进 %d 步，到达位置 %d\n", VERBOSITY_EVENTS },
+    [EVT_MOVE_BACKWARD] = { "%p 后退 %d 步，到达位置 %d\n", VERBOSITY_EVENTS },
+    [EVT_STEP_FORMAT_ERROR] = { "无效的 step 命令格式, e.g., step 5\n", VERBOSITY_EVENTS },
+
+    // 路障与机器娃娃
+    [EVT_BLOCK_INVALID_POSITION] = { "无效的放置位置。\n", VERBOSITY_EVENTS },
+    [EVT_BLOCK_SPECIAL_BUILDING] = { "不能在特殊建筑位置放置道具。\n", VERBOSITY_EVENTS },
+    [EVT_BLOCK_PLAYER_PRESENT] = { "不能在有玩家的位置放置道具。\n", VERBOSITY_EVENTS },
+    [EVT_BLOCK_EXISTS] = { "该位置已有路障，无法放置。\n", VERBOSITY_EVENTS },
+    [EVT_BLOCK_PLACED] = { "路障已放置在位置 %d。\n", VERBOSITY_EVENTS },
+    [EVT_BLOCK_REMOVED] = { "位置 %d 的路障已被移除。\n", VERBOSITY_EVENTS },
+    [EVT_BLOCK_INTERCEPTED] = { "玩家 %p 被位置 %d 的路障拦截！\n您被拦截在路障位置，无法继续前进。\n", VERBOSITY_EVENTS },
+    [EVT_BLOCK_NO_PROP] = { "您没有路障道具。\n", VERBOSITY_EVENTS },
+    [EVT_BLOCK_OUT_OF_MAP] = { "无效的放置位置。位置超出地图范围。\n", VERBOSITY_EVENTS },
+    [EVT_BLOCK_ON_SELF] = { "无效的放置位置。路障不能放置在当前位置。\n", VERBOSITY_EVENTS },
+    [EVT_BLOCK_OUT_OF_RANGE] = { "无效的放置距离。路障只能放置在前后 %d 步范围内，且不能放置在当前位置。\n", VERBOSITY_EVENTS },
+    [EVT_BLOCK_USED] = { "使用了一个路障道具。剩余路障：%d\n", VERBOSITY_EVENTS },
+    [EVT_PROP_CLEARED] = { "清除了位置 %d 的路障。\n", VERBOSITY_EVENTS },
+    [EVT_ROBOT_SWEEP_START] = { "机器娃娃开始清扫前方 %d 步内的道具...\n", VERBOSITY_FULL },
+    [EVT_ROBOT_NOTHING_FOUND] = { "前方 %d 步内没有发现任何道具。\n", VERBOSITY_FULL },
+    [EVT_ROBOT_SWEEP_DONE] = { "机器娃娃清扫完成，共清除了 %d 个道具。\n", VERBOSITY_EVENTS },
+    [EVT_ROBOT_NO_PROP] = { "您没有机器娃娃道具。\n", VERBOSITY_EVENTS },
+    [EVT_ROBOT_USE] = { "玩家 %p 使用机器娃娃清扫前方道具。\n", VERBOSITY_EVENTS },
+    [EVT_ROBOT_USED] = { "使用了一个机器娃娃道具。剩余机器娃娃：%d\n", VERBOSITY_EVENTS },
+    [EVT_ROBOT_WASTED] = { "虽然没有清除任何道具，但机器娃娃已被使用。\n", VERBOSITY_FULL },
+
+    // 土地
+    [EVT_LAND_NOT_FOR_SALE] = { "此地为特殊地点，不可购买。\n", VERBOSITY_EVENTS },
+    [EVT_LAND_OWNED_BY_SELF] = { "您已经是这块地的主人了。\n", VERBOSITY_EVENTS },
+    [EVT_LAND_OWNED_BY_OTHER] = { "此地已被其他玩家购买。\n", VERBOSITY_EVENTS },
+    [EVT_LAND_NO_FUND] = { "资金不足，无法购买此地。需要 %d，您只有 %d。\n", VERBOSITY_EVENTS },
+    [EVT_LAND_DECLINED] = { "您放弃了购买此地。\n", VERBOSITY_FULL },
+    [EVT_LAND_BOUGHT] = { "恭喜！您成功购买了此地。剩余资金: %d\n", VERBOSITY_EVENTS },
+    [EVT_UPGRADE_MAX_LEVEL] = { "您的房产已是最高级(摩天楼)，无法再升级。\n", VERBOSITY_EVENTS },
+    [EVT_UPGRADE_NO_FUND] = { "资金不足，无法升级。需要 %d，您只有 %d。\n", VERBOSITY_EVENTS },
+    [EVT_UPGRADED] = { "恭喜！升级成功。当前等级: %d，剩余资金: %d\n", VERBOSITY_EVENTS },
+    [EVT_UPGRADE_DECLINED] = { "您放弃了升级。\n", VERBOSITY_FULL },
+    [EVT_SELL_INVALID_LOCATION] = { "出售失败：无效的位置。\n", VERBOSITY_EVENTS },
+    [EVT_SELL_NOT_OWNER] = { "出售失败：这不是您的房产。\n", VERBOSITY_EVENTS },
+    [EVT_SOLD] = { "出售成功！您获得了 %d 元，当前总资金: %d\n", VERBOSITY_EVENTS },
+    [EVT_TOLL_UNOWNED] = { "您到达了一块空地，无需支付过路费。\n", VERBOSITY_FULL },
+    [EVT_TOLL_GOD_FREE] = { "财神附身，免除本次过路费！\n", VERBOSITY_EVENTS },
+    [EVT_TOLL_DUE] = { "您到达了玩家 %p 的地盘(等级 %d)，需支付过路费 %d 元。\n", VERBOSITY_EVENTS },
+    [EVT_BANKRUPT] = { "您的资金不足以支付过路费 %d 元，您已破产！\n您的所有资产（包括剩余资金 %d 元）已被系统没收。\n", VERBOSITY_EVENTS },
+    [EVT_BANKRUPT_CLEARED] = { "玩家 %p 的所有房产和道具已被清空。\n", VERBOSITY_EVENTS },
+    [EVT_TOLL_PAID] = { "支付成功。您的剩余资金: %d\n", VERBOSITY_EVENTS },
+    [EVT_ARRIVE_PROP_SHOP] = { "您到达了道具屋。\n", VERBOSITY_FULL },
+    [EVT_ARRIVE_START] = { "您到达了起点。\n", VERBOSITY_FULL },
+    [EVT_ARRIVE_PARK] = { "您到达了公园。\n", VERBOSITY_FULL },
+    [EVT_ARRIVE_MINE] = { "您到达了矿地，获得了 %d 点数！当前点数：%d\n", VERBOSITY_EVENTS },
+    [EVT_ARRIVE_SPECIAL] = { "您到达了特殊地点。\n", VERBOSITY_FULL },
+
+    // 礼品屋
+    [EVT_GIFT_WELCOME] = { "欢迎光临礼品屋，请选择一件您喜欢的礼品：\n1. 奖金 (2000元)\n2. 点数卡 (200点)\n3. 财神 (财神附身，5轮内免过路费)\n", VERBOSITY_FULL },
+    [EVT_GIFT_BONUS] = { "您获得了 2000 元奖金！\n", VERBOSITY_EVENTS },
+    [EVT_GIFT_CREDIT] = { "您获得了 200 点数！\n", VERBOSITY_EVENTS },
+    [EVT_GIFT_GOD] = { "财神已附身！5轮内免过路费。\n", VERBOSITY_EVENTS },
+    [EVT_GIFT_INVALID] = { "无效的选择，您放弃了这次机会。\n", VERBOSITY_EVENTS },
+
+    // 道具屋
+    [EVT_SHOP_NO_CREDIT] = { "您的点数不足以购买任何道具，自动退出道具屋。\n", VERBOSITY_EVENTS },
+    [EVT_SHOP_EXIT] = { "您退出了道具屋。\n", VERBOSITY_FULL },
+    [EVT_SHOP_FULL] = { "您的道具已满，自动退出道具屋。\n", VERBOSITY_EVENTS },
+
+    // 财神
+    [EVT_GOD_LEFT] = { "财神在位置 %d 停留时间结束，消失了。\n", VERBOSITY_EVENTS },
+    [EVT_GOD_APPEARED] = { "财神出现在地图位置 %d！\n", VERBOSITY_EVENTS },
+    [EVT_GOD_MET] = { "玩家 %p 在位置 %d 遇到了财神！获得财神附身效果。\n", VERBOSITY_EVENTS },
+    [EVT_GOD_BUFF] = { "玩家 %p 有财神附身，免过路费，剩余 %d 回合。\n", VERBOSITY_FULL },
+
+    // 回合与游戏
+    [EVT_PLAYER_SKIPPED] = { "玩家 %p 已破产，自动跳过。\n", VERBOSITY_EVENTS },
+    [EVT_GAME_WINNER] = { "游戏结束！胜利者是 %p！\n", VERBOSITY_EVENTS },
+    [EVT_GAME_ALL_BANKRUPT] = { "所有玩家都已破产，游戏结束！\n", VERBOSITY_EVENTS },
+
+    // 查询
+    [EVT_QUERY_HEADER] = { "资产查询:\n", VERBOSITY_EVENTS },
+    [EVT_QUERY_PLAYER] = { "  玩家: %p\n", VERBOSITY_EVENTS },
+    [EVT_QUERY_FUND] = { "  资金: %d 元\n", VERBOSITY_EVENTS },
+    [EVT_QUERY_CREDIT] = { "  点数: %d 点\n", VERBOSITY_EVENTS },
+    [EVT_QUERY_LOCATION] = { "  位置: %d\n", VERBOSITY_EVENTS },
+    [EVT_QUERY_PROPS] = { "  道具:\n", VERBOSITY_EVENTS },
+    [EVT_QUERY_BARRIER] = { "    - 路障: %d\n", VERBOSITY_EVENTS },
+    [EVT_QUERY_ROBOT] = { "    - 机器娃娃: %d\n", VERBOSITY_EVENTS },
+    [EVT_QUERY_STATUS] = { "  状态:\n", VERBOSITY_EVENTS },
+    [EVT_QUERY_GOD_BUFF] = { "    - 财神附身: 剩余 %d 回合\n", VERBOSITY_EVENTS },
+    [EVT_QUERY_PRISON] = { "    - 监狱: 剩余 %d 回合\n", VERBOSITY_EVENTS },
+    [EVT_QUERY_HOSPITAL] = { "    - 医院: 剩余 %d 回合\n", VERBOSITY_EVENTS },
+    [EVT_QUERY_NO_STATUS] = { "    - (无特殊状态)\n", VERBOSITY_EVENTS },
+    [EVT_QUERY_HOUSES] = { "  房产:\n", VERBOSITY_EVENTS },
+    [EVT_QUERY_HOUSE] = { "    - 位置 %d (等级 %d)\n", VERBOSITY_EVENTS },
+    [EVT_QUERY_NO_HOUSE] = { "    (无)\n", VERBOSITY_EVENTS },
+    [EVT_QUERY_GOD_HEADER] = { "  地图财神状态:\n", VERBOSITY_EVENTS },
+    [EVT_QUERY_GOD_ON_MAP] = { "    - 位置: %d (剩余 %d 回合消失)\n", VERBOSITY_EVENTS },
+    [EVT_QUERY_GOD_ABSENT] = { "    - (未出现，预计 %d 回合后出现)\n", VERBOSITY_EVENTS },
+
+    // 命令
+    [EVT_HELP] = { HELP_TEXT, VERBOSITY_EVENTS },
+    [EVT_QUIT] = { "游戏已退出。\n", VERBOSITY_EVENTS },
+    [EVT_UNKNOWN_COMMAND] = { "未知命令: %s\n", VERBOSITY_EVENTS },
+    [EVT_SELL_FORMAT_ERROR] = { "格式错误，请使用: sell <位置>\n", VERBOSITY_EVENTS },
+    [EVT_BLOCK_FORMAT_ERROR] = { "格式错误，请使用: block <相对距离>\n", VERBOSITY_EVENTS },
+    [EVT_PLAYER_CREATED] = { "创建玩家成功: %p\n", VERBOSITY_EVENTS },
+    [EVT_PLAYER_CREATE_FAILED] = { "创建玩家失败\n", VERBOSITY_EVENTS },
+    [EVT_CREATE_PLAYER_FORMAT_ERROR] = { "格式错误，请使用: create_player <姓名> <资金>\n", VERBOSITY_EVENTS },
+    [EVT_DUMP_SAVED] = { "游戏状态已保存到: %s\n", VERBOSITY_EVENTS },
+    [EVT_DUMP_FAILED] = { "保存失败: %s\n", VERBOSITY_EVENTS },
+    [EVT_DUMP_FORMAT_ERROR] = { "格式错误，请使用: dump 或 dump <文件名>\n", VERBOSITY_EVENTS },
+    [EVT_LOADED] = { "游戏状态已从 %s 加载\n", VERBOSITY_EVENTS },
+    [EVT_LOAD_FAILED] = { "加载失败: %s\n", VERBOSITY_EVENTS },
+    [EVT_LOAD_FORMAT_ERROR] = { "格式错误，请使用: load <文件名>\n", VERBOSITY_EVENTS },
+
+    // 缓冲区
+    [EVT_EVENTS_DROPPED] = { "（消息过多，省略了之前的 %d 条）\n", VERBOSITY_EVENTS },
+};
+
+const MessageTemplate* message_template(EventId id) {
+    static const MessageTemplate s_empty = { "", VERBOSITY_FULL };
+    if ((unsigned)id >= EVT_COUNT || s_catalog[id].text == NULL) {
+        return &s_empty;
+    }
+    return &s_catalog[id];
+}
+
+bool parse_verbosity(const char* name, Verbosity* verbosity) {
+    if (strcmp(name, "quiet") == 0) *verbosity = VERBOSITY_QUIET;
+    else if (strcmp(name, "events") == 0) *verbosity = VERBOSITY_EVENTS;
+    else if (strcmp(name, "full") == 0) *verbosity = VERBOSITY_FULL;
+    else return false;
+    return true;
+}
@@ -0,0 +1,18 @@
+#ifndef MESSAGE_CATALOG_H
+#define MESSAGE_CATALOG_H
+
+#include <stdbool.h>
+#include "event_log.h"
+
+// 一条消息模板：静态文本及其所属的详细程度
+typedef struct {
+    const char* text;
+    Verbosity level;    // 详细程度不低于该级别时才记录
+} MessageTemplate;
+
+const MessageTemplate* message_template(EventId id);
+
+// 按名称解析详细程度（quiet/events/full），无法识别返回 false
+bool parse_verbosity(const char* name, Verbosity* verbosity);
+
+#endif // MESSAGE_CATALOG_H
@@ -0,0 +1,82 @@
+#include "movement.h"
+#include "block_system.h"
+#include "god_system.h"
+#include "tile_set.h"
+#include "occupancy.h"
+#include <stdlib.h>
+
+// 向 direction 方向（1 或 -1）走 1..open_steps 步时第一次到达财神所在格的步数，没有返回 0
+static int god_distance(const GameContext* ctx, int from, int open_steps, int direction) {
+    const Board* board = ctx->board;
+    int size = board->size;
+    int god = ctx->state.god.location;
+    if (!board_contains(board, god) || open_steps <= 0) {
+        return 0;
+    }
+    if (board_contains(board, from)) {
+        int distance = direction > 0 ? god - from : from - god;
+        if (distance <= 0) {
+            distance += size; // 原地的财神要走满一圈才会遇到
+        }
+        return distance <= open_steps ? distance : 0;
+    }
+
+    // 起点不在地图内（旧存档中的异常位置）时按原来的取模方式逐步检查；
+    // 走过 |from| + 2 圈之后不会再出现新的格子
+    int limit = abs(from) + 2 * size;
+    if (open_steps > limit) open_steps = limit;
+    for (int i = 1; i <= open_steps; i++) {
+        int next = direction > 0 ? (from + i) % size : (from - i + size) % size;
+        if (next == god) {
+            return i;
+        }
+    }
+    return 0;
+}
+
+MovePlan plan_move(const GameContext* ctx, int from, int steps) {
+    MovePlan plan = { from, 0, steps, false, 0 };
+    int size = ctx->board->size;
+    const TileSet* barrier = &ctx->state.placed_prop.barrier;
+    int direction = steps < 0 ? -1 : 1;
+    int distance = steps < 0 ? -steps : steps;
+
+    // 路障：拦截在第一个路障处
+    int block_steps = direction > 0 ? tile_set_first_ahead(barrier, size, from, distance)
+                                    : tile_set_first_behind(barrier, size, from, distance);
+    if (block_steps > 0) {
+        plan.blocked = true;
+        distance = block_steps;
+        plan.steps = direction * block_steps;
+    }
+    if (direction > 0) {
+        plan.to = (from + distance) % size;
+    } else {
+        plan.to = (from - distance + size) % size;
+    }
+
+    // 财神：只在路障之前的格子上触发，遇到后不停下
+    plan.god_steps = god_distance(ctx, from, plan.blocked ? distance - 1 : distance, direction);
+    return plan;
+}
+
+void execute_move(GameContext* ctx, Player* player, const MovePlan* plan, InterceptTiming timing) {
+    if (plan->god_steps > 0) {
+        trigger_god_encounter(ctx, player, ctx->state.god.location);
+    }
+
+    if (plan->blocked && timing == INTERCEPT_BEFORE_LANDING) {
+        trigger_block_interception(ctx, player, plan->to);
+    }
+
+    player_set_location(ctx, player, plan->to);
+    if (plan->steps < 0) {
+        emit_event3(ctx, EVT_MOVE_BACKWARD, player_slot(ctx, player), -plan->steps, player->location);
+    } else {
+        emit_event3(ctx, EVT_MOVE_FORWARD, player_slot(ctx, player), plan->steps, player->location);
+    }
+
+    if (plan->blocked && timing == INTERCEPT_AFTER_LANDING) {
+        trigger_block_interception(ctx, player, plan->to);
+    }
+}
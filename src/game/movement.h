@@ -0,0 +1,29 @@
+#ifndef MOVEMENT_H
+#define MOVEMENT_H
+
+#include "game_types.h"
+#include "game_context.h"
+
+// 路障拦截效果的触发时机：掷骰在落地前触发，遥控骰子在落地后触发
+typedef enum {
+    INTERCEPT_BEFORE_LANDING,
+    INTERCEPT_AFTER_LANDING
+} InterceptTiming;
+
+// 一次移动的结算结果，只由当前状态计算，不修改状态
+typedef struct {
+    int from;
+    int to;
+    int steps;          // 实际移动的步数，后退为负数
+    bool blocked;       // 被路障拦截，停在 to
+    int god_steps;      // 途经财神时走到财神所在格的步数，没有遇到为 0
+} MovePlan;
+
+// 结算从 from 移动 steps 步（负数为后退）：路障用位集一次定位，财神按距离直接计算，
+// 与步数无关
+MovePlan plan_move(const GameContext* ctx, int from, int steps);
+
+// 按结算结果移动玩家：触发途经的财神，更新位置并输出移动事件，按 timing 触发路障拦截
+void execute_move(GameContext* ctx, Player* player, const MovePlan* plan, InterceptTiming timing);
+
+#endif // MOVEMENT_H
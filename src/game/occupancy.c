@@ -0,0 +1,47 @@
+#include "occupancy.h"
+#include <string.h>
+
+static void occupancy_insert(GameContext* ctx, const Player* player) {
+    if (!board_contains(ctx->board, player->location)) {
+        return;
+    }
+    ctx->state.occupancy.players[player->location]++;
+    if (player->alive) {
+        ctx->state.occupancy.alive[player->location]++;
+    }
+}
+
+static void occupancy_erase(GameContext* ctx, const Player* player) {
+    if (!board_contains(ctx->board, player->location)) {
+        return;
+    }
+    ctx->state.occupancy.players[player->location]--;
+    if (player->alive) {
+        ctx->state.occupancy.alive[player->location]--;
+    }
+}
+
+void occupancy_rebuild(GameContext* ctx) {
+    size_t size = (size_t)ctx->board->size;
+    memset(ctx->state.occupancy.players, 0, size);
+    memset(ctx->state.occupancy.alive, 0, size);
+    for (int i = 0; i < ctx->state.player_count; i++) {
+        occupancy_insert(ctx, &ctx->state.players[i]);
+    }
+}
+
+void occupancy_add(GameContext* ctx, const Player* player) {
+    occupancy_insert(ctx, player);
+}
+
+void player_set_location(GameContext* ctx, Player* player, int location) {
+    occupancy_erase(ctx, player);
+    player->location = location;
+    occupancy_insert(ctx, player);
+}
+
+void player_set_alive(GameContext* ctx, Player* player, bool alive) {
+    occupancy_erase(ctx, player);
+    player->alive = alive;
+    occupancy_insert(ctx, player);
+}
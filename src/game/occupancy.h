@@ -0,0 +1,30 @@
+#ifndef OCCUPANCY_H
+#define OCCUPANCY_H
+
+#include "game_types.h"
+#include "game_context.h"
+
+// 格子占用索引：每格上的玩家数，放置检查和财神出现检查不再逐个遍历玩家
+// 游戏过程中玩家的位置和存活状态只能通过下列函数修改；
+// 批量写入 players[]（加载存档、快照）后调用 occupancy_rebuild
+// 地图外的位置（旧存档中的异常值）不计入索引
+
+void occupancy_rebuild(GameContext* ctx);
+
+// 新加入的玩家计入索引（players[] 中已填好位置和存活状态）
+void occupancy_add(GameContext* ctx, const Player* player);
+
+void player_set_location(GameContext* ctx, Player* player, int location);
+void player_set_alive(GameContext* ctx, Player* player, bool alive);
+
+// 位置上的玩家数（含已破产的玩家），地图外返回 0
+static inline int players_at(const GameContext* ctx, int location) {
+    return board_contains(ctx->board, location) ? ctx->state.occupancy.players[location] : 0;
+}
+
+// 位置上未破产的玩家数，地图外返回 0
+static inline int alive_players_at(const GameContext* ctx, int location) {
+    return board_contains(ctx->board, location) ? ctx->state.occupancy.alive[location] : 0;
+}
+
+#endif // OCCUPANCY_H
@@ -0,0 +1,110 @@
+#include "ownership.h"
+#include "game_state.h"
+#include "tile_set.h"
+#include <string.h>
+
+// 只有合法的玩家编号进入索引；其他 owner_id（无主或存档中的异常值）按原样保存在 houses[] 中
+static bool indexed_owner(int owner_id) {
+    return owner_id >= 0 && owner_id < MAX_PLAYERS;
+}
+
+// 与出售价格的计算一致：地价乘以（1 + 等级）
+static int house_investment(const House* house) {
+    return house->price * (1 + house->level);
+}
+
+static void holdings_add(GameContext* ctx, int location) {
+    const House* house = &ctx->state.houses[location];
+    if (!indexed_owner(house->owner_id)) {
+        return;
+    }
+    Holdings* holdings = &ctx->state.holdings[house->owner_id];
+    tile_set_add(&holdings->tiles, location);
+    holdings->count++;
+    holdings->investment += house_investment(house);
+    holdings->district_count[board_district(ctx->board, location)]++;
+}
+
+static void holdings_remove(GameContext* ctx, int location) {
+    const House* house = &ctx->state.houses[location];
+    if (!indexed_owner(house->owner_id)) {
+        return;
+    }
+    Holdings* holdings = &ctx->state.holdings[house->owner_id];
+    tile_set_remove(&holdings->tiles, location);
+    holdings->count--;
+    holdings->investment -= house_investment(house);
+    holdings->district_count[board_district(ctx->board, location)]--;
+}
+
+void ownership_rebuild(GameContext* ctx) {
+    memset(ctx->state.holdings, 0, sizeof(ctx->state.holdings));
+    for (int i = 0; i < ctx->board->size; i++) {
+        holdings_add(ctx, i);
+    }
+}
+
+void house_set_owner(GameContext* ctx, int location, int owner_id) {
+    if (!board_contains(ctx->board, location)) {
+        return;
+    }
+    House* house = &ctx->state.houses[location];
+    holdings_remove(ctx, location);
+    house->owner_id = owner_id;
+    if (owner_id == -1) {
+        house->level = 0;
+    }
+    holdings_add(ctx, location);
+}
+
+void house_set_level(GameContext* ctx, int location, int level) {
+    if (!board_contains(ctx->board, location)) {
+        return;
+    }
+    holdings_remove(ctx, location);
+    ctx->state.houses[location].level = level;
+    holdings_add(ctx, location);
+}
+
+int release_player_houses(GameContext* ctx, int owner_id) {
+    int released = 0;
+    for (int loc = next_owned_house(ctx, owner_id, -1); loc >= 0; loc = next_owned_house(ctx, owner_id, loc)) {
+        house_set_owner(ctx, loc, -1);
+        released++;
+    }
+    return released;
+}
+
+int next_owned_house(const GameContext* ctx, int owner_id, int after) {
+    int from = after + 1;
+    if (from < 0) from = 0;
+    int size = ctx->board->size;
+    if (from >= size) {
+        return -1;
+    }
+    if (indexed_owner(owner_id)) {
+        return tile_set_first_in(&ctx->state.holdings[owner_id].tiles, from, size - 1);
+    }
+    for (int i = from; i < size; i++) {
+        if (ctx->state.houses[i].owner_id == owner_id) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+const Holdings* player_holdings(const GameContext* ctx, int owner_id) {
+    return indexed_owner(owner_id) ? &ctx->state.holdings[owner_id] : NULL;
+}
+
+int player_net_worth(const GameContext* ctx, const Player* player) {
+    const Holdings* holdings = player_holdings(ctx, player->index);
+    if (holdings) {
+        return player->fund + holdings->investment;
+    }
+    int worth = player->fund;
+    for (int loc = next_owned_house(ctx, player->index, -1); loc >= 0; loc = next_owned_house(ctx, player->index, loc)) {
+        worth += house_investment(&ctx->state.houses[loc]);
+    }
+    return worth;
+}
@@ -0,0 +1,29 @@
+#ifndef OWNERSHIP_H
+#define OWNERSHIP_H
+
+#include "game_types.h"
+#include "game_context.h"
+
+// 房产归属索引：每位玩家一个地块位集和若干汇总值
+// 游戏过程中房产的归属和等级只能通过下列函数修改；
+// 批量写入 houses[]（加载存档、快照、修改地价）后调用 ownership_rebuild
+
+void ownership_rebuild(GameContext* ctx);
+
+// 设置地块归属，owner_id 为 -1 表示收回为空地（等级同时清零）
+void house_set_owner(GameContext* ctx, int location, int owner_id);
+void house_set_level(GameContext* ctx, int location, int level);
+
+// 收回玩家的全部房产，返回收回的地块数
+int release_player_houses(GameContext* ctx, int owner_id);
+
+// 遍历玩家的房产：after 传 -1 取第一块，之后传上一块的位置，结束返回 -1
+int next_owned_house(const GameContext* ctx, int owner_id, int after);
+
+// 玩家的房产汇总，owner_id 不在索引范围内时返回 NULL
+const Holdings* player_holdings(const GameContext* ctx, int owner_id);
+
+// 净资产：现金加房产总投资
+int player_net_worth(const GameContext* ctx, const Player* player);
+
+#endif // OWNERSHIP_H
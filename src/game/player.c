@@ -1,15 +1,13 @@
 #include "player.h"
 #include "character.h"
+#include "occupancy.h"
 #include "../io/colors.h" // 包含颜色定义
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 
-// 外部游戏状态声明
-extern GameState g_game_state;
-
-Player* create_player_by_character(int character_id, int fund) {
-    if (!is_valid_character_id(character_id) || g_game_state.player_count >= MAX_PLAYERS) {
+Player* create_player_by_character(GameContext* ctx, int character_id, int fund) {
+    if (!is_valid_character_id(character_id) || ctx->state.player_count >= MAX_PLAYERS) {
         return NULL;
     }
     
@@ -18,10 +16,9 @@ Player* create_player_by_character(int character_id, int fund) {
         return NULL;
     }
     
-    Player* player = &g_game_state.players[g_game_state.player_count];
-    player->index = g_game_state.player_count;  // 从0开始
-    strncpy(player->name, character->name, sizeof(player->name) - 1);
-    player->name[sizeof(player->name) - 1] = '\0';
+    Player* player = &ctx->state.players[ctx->state.player_count];
+    player->index = ctx->state.player_count;  // 从0开始
+    snprintf(player->name, sizeof(player->name), "%s", character->name);
     player->fund = fund;
     player->credit = 0;
     player->location = 0;
@@ -47,19 +44,28 @@ Player* create_player_by_character(int character_id, int fund) {
     player->buff.prison = 0;
     player->buff.hospital = 0;
     
-    g_game_state.player_count++;
+    ctx->state.player_count++;
+    occupancy_add(ctx, player);
     return player;
 }
 
-Player* create_player(int index, const char* name, int fund) {
-    if (index < 0 || index >= MAX_PLAYERS || g_game_state.player_count >= MAX_PLAYERS) {
+// 按角色名确定显示颜色（从存档恢复玩家时使用）
+const char* player_color_by_name(const char* name) {
+    if (strcmp(name, "钱夫人") == 0) return COLOR_RED;
+    if (strcmp(name, "阿土伯") == 0) return COLOR_GREEN;
+    if (strcmp(name, "孙小美") == 0) return COLOR_BLUE;
+    if (strcmp(name, "金贝贝") == 0) return COLOR_YELLOW;
+    return COLOR_RESET;
+}
+
+Player* create_player(GameContext* ctx, int index, const char* name, int fund) {
+    if (index < 0 || index >= MAX_PLAYERS || ctx->state.player_count >= MAX_PLAYERS) {
         return NULL;
     }
     
-    Player* player = &g_game_state.players[g_game_state.player_count];
+    Player* player = &ctx->state.players[ctx->state.player_count];
     player->index = index;
-    strncpy(player->name, name, sizeof(player->name) - 1);
-    player->name[sizeof(player->name) - 1] = '\0';
+    snprintf(player->name, sizeof(player->name), "%s", name);
     player->fund = fund;
     player->credit = 0;
     player->location = 0;
@@ -76,12 +82,13 @@ Player* create_player(int index, const char* name, int fund) {
     player->buff.prison = 0;
     player->buff.hospital = 0;
     
-    g_game_state.player_count++;
+    ctx->state.player_count++;
+    occupancy_add(ctx, player);
     return player;
 }
 
 void free_player(Player* player) {
-    // 目前玩家存储在全局状态中，不需要单独释放
+    // 目前玩家存储在游戏上下文中，不需要单独释放
     // 如果将来改为动态分配，可以在这里释放
     (void)player; // 避免未使用参数警告
 }
@@ -93,7 +100,7 @@ bool is_player_valid(const Player* player) {
 void print_player_info(const Player* player) {
     if (!player) return;
     
-    printf("玩家%d: %s, 资金:%d, 位置:%d, 存活:%s\n", 
+    output_printf("玩家%d: %s, 资金:%d, 位置:%d, 存活:%s\n", 
            player->index, player->name, player->fund, player->location, 
            player->alive ? "是" : "否");
 }
\ No newline at end of file
@@ -2,12 +2,14 @@
 #define PLAYER_H
 
 #include "game_types.h"
+#include "game_context.h"
 
 // 玩家管理函数声明
-Player* create_player_by_character(int character_id, int fund);
-Player* create_player(int index, const char* name, int fund);
+Player* create_player_by_character(GameContext* ctx, int character_id, int fund);
+Player* create_player(GameContext* ctx, int index, const char* name, int fund);
 void free_player(Player* player);
 bool is_player_valid(const Player* player);
 void print_player_info(const Player* player);
+const char* player_color_by_name(const char* name);
 
 #endif // PLAYER_H
\ No newline at end of file
@@ -1,10 +1,7 @@
 #include "prop_shop.h"
 #include "game_state.h"
-#include "../io/command_processor.h" // 包含 g_last_action_message
-#include <stdio.h>
-#include <stdlib.h>
-#include <string.h>
-#include <ctype.h>
+#include "decision.h"
+#include "../io/utils.h"
 
 // 道具信息结构体
 typedef struct {
@@ -50,46 +47,46 @@ bool has_prop_space(Player* player) {
 }
 
 // 显示道具屋菜单
-void show_prop_shop_menu(void) {
-    printf("\n");
-    printf("欢迎光临道具屋，请选择您所需要的道具：\n");
-    printf("\n");
-    printf("道具      编号    价值（点数）    显示方式    拥有数量\n");
-    printf("----------------------------------------------------\n");
+void show_prop_shop_menu(GameContext* ctx) {
+    prompt_printf(ctx, "\n");
+    prompt_printf(ctx, "欢迎光临道具屋，请选择您所需要的道具：\n");
+    prompt_printf(ctx, "\n");
+    prompt_printf(ctx, "道具      编号    价值（点数）    显示方式    拥有数量\n");
+    prompt_printf(ctx, "----------------------------------------------------\n");
     
     for (int i = 0; i < prop_count; i++) {
         PropInfo* prop = &prop_info[i];
         int owned_count = 0;
         if (prop->id == 1) { // 路障
-            owned_count = g_game_state.players[g_game_state.game.now_player_id].prop.barrier;
+            owned_count = ctx->state.players[ctx->state.game.now_player_id].prop.barrier;
         } else if (prop->id == 2) { // 机器娃娃
-            owned_count = g_game_state.players[g_game_state.game.now_player_id].prop.robot;
+            owned_count = ctx->state.players[ctx->state.game.now_player_id].prop.robot;
         }
-        printf("%-10s %-8d %-12d %-10s %d\n", 
+        prompt_printf(ctx, "%-10s %-8d %-12d %-10s %d\n", 
                prop->name, prop->id, prop->price, prop->display_symbol, owned_count);
     }
-    printf("\n");
-    printf("请输入道具编号选择道具，按F退出道具屋：");
+    prompt_printf(ctx, "\n");
+    prompt_printf(ctx, "请输入道具编号选择道具，按F退出道具屋：");
 }
 
 // 购买道具核心逻辑
-bool buy_prop(Player* player, int prop_id) {
+bool buy_prop(GameContext* ctx, Player* player, int prop_id) {
     // 验证道具ID
     if (prop_id < 1 || prop_id > prop_count) {
-        printf("无效的道具编号。\n");
+        prompt_printf(ctx, "无效的道具编号。\n");
         return false;
     }
     
     // 检查道具空间
     if (!has_prop_space(player)) {
-        printf("您的道具已达到上限（%d个），无法购买更多道具。\n", MAX_PROPS);
+        prompt_printf(ctx, "您的道具已达到上限（%d个），无法购买更多道具。\n", MAX_PROPS);
         return false;
     }
     
     // 检查点数是否足够
     if (!can_afford_prop(player, prop_id)) {
         int price = get_prop_price(prop_id);
-        printf("点数不足，无法购买%s。需要%d点数，您只有%d点数。\n", 
+        prompt_printf(ctx, "点数不足，无法购买%s。需要%d点数，您只有%d点数。\n", 
                get_prop_name(prop_id), price, player->credit);
         return false;
     }
@@ -110,53 +107,39 @@ bool buy_prop(Player* player, int prop_id) {
     
     player->prop.total++;
     
-    printf("购买成功！您获得了%s。剩余点数：%d\n", 
+    prompt_printf(ctx, "购买成功！您获得了%s。剩余点数：%d\n", 
            get_prop_name(prop_id), player->credit);
     
     return true;
 }
 
 // 进入道具屋主逻辑
-void enter_prop_shop(Player* player) {
+void enter_prop_shop(GameContext* ctx, Player* player) {
     // 首先检查玩家是否有点数购买最便宜的道具
     int min_price = PROP_ROBOT_PRICE; // 机器娃娃是最便宜的(30点)
     if (player->credit < min_price) {
-        printf("您的点数不足以购买任何道具，自动退出道具屋。\n");
-        // 将消息也写入全局缓冲区，以便在返回主循环后显示
-        snprintf(g_last_action_message, sizeof(g_last_action_message), "您的点数不足以购买任何道具，自动退出道具屋。\n");
+        prompt_printf(ctx, "您的点数不足以购买任何道具，自动退出道具屋。\n");
+        // 同时记录事件（覆盖之前的消息），以便在返回主循环后显示
+        event_log_clear(&ctx->events);
+        emit_event(ctx, EVT_SHOP_NO_CREDIT);
         return;
     }
     
-    char input[10];
-    
     while (true) {
-        // 交互式内容保留 printf
-        show_prop_shop_menu();
-        
-        if (fgets(input, sizeof(input), stdin) == NULL) {
+        int prop_id = decide_prop(ctx, player);
+        if (prop_id == PROP_CHOICE_END) {
             break;
         }
         
-        // 移除换行符
-        input[strcspn(input, "\n")] = 0;
-        
-        // 检查是否退出 (F或f)
-        if (tolower(input[0]) == 'f') {
-            printf("您退出了道具屋。\n");
-            snprintf(g_last_action_message, sizeof(g_last_action_message), "您退出了道具屋。\n");
+        if (prop_id == PROP_CHOICE_EXIT) {
+            prompt_printf(ctx, "您退出了道具屋。\n");
+            event_log_clear(&ctx->events);
+            emit_event(ctx, EVT_SHOP_EXIT);
             break;
         }
         
-        // 尝试解析道具编号
-        int prop_id = atoi(input);
-        if (prop_id == 0 && input[0] != '0') {
-            // 交互式错误提示
-            printf("无效输入，请输入道具编号或F退出。\n");
-            continue;
-        }
-        
         // 尝试购买道具
-        if (buy_prop(player, prop_id)) {
+        if (buy_prop(ctx, player, prop_id)) {
             // 购买成功后，消息已在 buy_prop 中通过 printf 直接显示
             // 检查是否还能继续购买
             bool can_buy_any = false;
@@ -169,25 +152,20 @@ void enter_prop_shop(Player* player) {
             
             // 如果不能再购买任何道具，自动退出
             if (!can_buy_any) {
-                char message_buffer[256];
                 if (!has_prop_space(player)) {
-                    printf("您的道具已满，自动退出道具屋。\n");
-                    snprintf(message_buffer, sizeof(message_buffer), "您的道具已满，自动退出道具屋。\n");
+                    prompt_printf(ctx, "您的道具已满，自动退出道具屋。\n");
+                    emit_event(ctx, EVT_SHOP_FULL);
                 } else {
-                    printf("您的点数不足以购买任何道具，自动退出道具屋。\n");
-                    snprintf(message_buffer, sizeof(message_buffer), "您的点数不足以购买任何道具，自动退出道具屋。\n");
+                    prompt_printf(ctx, "您的点数不足以购买任何道具，自动退出道具屋。\n");
+                    emit_event(ctx, EVT_SHOP_NO_CREDIT);
                 }
-                // 将最终退出消息写入全局缓冲区
-                strncat(g_last_action_message, message_buffer, sizeof(g_last_action_message) - strlen(g_last_action_message) - 1);
                 break;
             }
         } else {
             // 购买失败，检查是否应该退出道具屋
             if (!has_prop_space(player)) {
-                char message_buffer[256];
-                printf("您的道具已满，自动退出道具屋。\n");
-                snprintf(message_buffer, sizeof(message_buffer), "您的道具已满，自动退出道具屋。\n");
-                strncat(g_last_action_message, message_buffer, sizeof(g_last_action_message) - strlen(g_last_action_message) - 1);
+                prompt_printf(ctx, "您的道具已满，自动退出道具屋。\n");
+                emit_event(ctx, EVT_SHOP_FULL);
                 break;
             }
         }
@@ -0,0 +1,112 @@
+#ifndef TILE_SET_H
+#define TILE_SET_H
+
+#include "game_types.h"
+#include <string.h>
+
+// 格子位集操作：按 64 位字整体处理，区间查找用 ctz/clz 一步定位
+// 超出容量的格子编号视为空格子，写操作直接忽略；环形查找由调用方给出地图格子数
+
+static inline bool tile_in_range(int tile) {
+    return tile >= 0 && tile < MAX_MAP_SIZE;
+}
+
+static inline void tile_set_clear_all(TileSet* set) {
+    memset(set->words, 0, sizeof(set->words));
+}
+
+static inline bool tile_set_has(const TileSet* set, int tile) {
+    return tile_in_range(tile) && (set->words[tile >> 6] >> (tile & 63) & 1);
+}
+
+static inline void tile_set_add(TileSet* set, int tile) {
+    if (tile_in_range(tile)) {
+        set->words[tile >> 6] |= 1ULL << (tile & 63);
+    }
+}
+
+static inline void tile_set_remove(TileSet* set, int tile) {
+    if (tile_in_range(tile)) {
+        set->words[tile >> 6] &= ~(1ULL << (tile & 63));
+    }
+}
+
+// 字内 [lo, hi] 位的掩码（0 <= lo <= hi <= 63）
+static inline uint64_t tile_word_mask(int lo, int hi) {
+    return (~0ULL << lo) & (~0ULL >> (63 - hi));
+}
+
+// [lo, hi] 内编号最小的格子，没有返回 -1（调用方保证 0 <= lo、hi < MAX_MAP_SIZE）
+static inline int tile_set_first_in(const TileSet* set, int lo, int hi) {
+    if (lo > hi) return -1;
+    int last = hi >> 6;
+    for (int w = lo >> 6; w <= last; w++) {
+        uint64_t bits = set->words[w] & tile_word_mask(w == lo >> 6 ? lo & 63 : 0, w == last ? hi & 63 : 63);
+        if (bits) {
+            return (w << 6) + __builtin_ctzll(bits);
+        }
+    }
+    return -1;
+}
+
+// [lo, hi] 内编号最大的格子，没有返回 -1
+static inline int tile_set_last_in(const TileSet* set, int lo, int hi) {
+    if (lo > hi) return -1;
+    int first = lo >> 6;
+    for (int w = hi >> 6; w >= first; w--) {
+        uint64_t bits = set->words[w] & tile_word_mask(w == first ? lo & 63 : 0, w == hi >> 6 ? hi & 63 : 63);
+        if (bits) {
+            return (w << 6) + 63 - __builtin_clzll(bits);
+        }
+    }
+    return -1;
+}
+
+// 清除 [lo, hi] 内的全部格子
+static inline void tile_set_clear_range(TileSet* set, int lo, int hi) {
+    if (lo > hi) return;
+    int first = lo >> 6;
+    int last = hi >> 6;
+    for (int w = first; w <= last; w++) {
+        set->words[w] &= ~tile_word_mask(w == first ? lo & 63 : 0, w == last ? hi & 63 : 63);
+    }
+}
+
+// 在 size 格的环形地图上从 start 向前走 1..steps 步经过的第一个格子，返回步数，没有返回 0
+// 超过一圈的部分不会再遇到新格子，最多检查 size 步（第 size 步回到 start）
+static inline int tile_set_first_ahead(const TileSet* set, int size, int start, int steps) {
+    if (start < 0 || start >= size || steps <= 0) return 0;
+    if (steps > size) steps = size;
+    int end = start + steps;
+    int tile = tile_set_first_in(set, start + 1, end < size ? end : size - 1);
+    if (tile >= 0) {
+        return tile - start;
+    }
+    if (end >= size) {
+        tile = tile_set_first_in(set, 0, end - size);
+        if (tile >= 0) {
+            return tile + size - start;
+        }
+    }
+    return 0;
+}
+
+// 从 start 向后退 1..steps 步经过的第一个格子，返回步数，没有返回 0
+static inline int tile_set_first_behind(const TileSet* set, int size, int start, int steps) {
+    if (start < 0 || start >= size || steps <= 0) return 0;
+    if (steps > size) steps = size;
+    int end = start - steps;
+    int tile = tile_set_last_in(set, end > 0 ? end : 0, start - 1);
+    if (tile >= 0) {
+        return start - tile;
+    }
+    if (end < 0) {
+        tile = tile_set_last_in(set, end + size, size - 1);
+        if (tile >= 0) {
+            return start + size - tile;
+        }
+    }
+    return 0;
+}
+
+#endif // TILE_SET_H
@@ -0,0 +1,109 @@
+#include "batch.h"
+#include "command_processor.h"
+#include "json_serializer.h"
+#include <stdlib.h>
+#include <string.h>
+
+typedef struct {
+    FILE* script;
+    BatchStats* stats;
+    DumpSink dump; // 调用方安装的存档方式
+} BatchReader;
+
+// 交互应答取脚本的下一行，与终端从标准输入读取完全一致
+static char* batch_prompt_answer(GameContext* ctx, PromptKind kind, char* buffer, int size) {
+    (void)kind;
+    BatchReader* reader = (BatchReader*)ctx->io.user_data;
+    char* answer = fgets(buffer, size, reader->script);
+    if (answer) {
+        reader->stats->prompts++;
+    }
+    return answer;
+}
+
+// dump 命令照常保存，并记下失败的文件
+static int batch_save_dump(const GameContext* ctx, const char* filename, void* user_data) {
+    BatchReader* reader = (BatchReader*)user_data;
+    int result = reader->dump.save ? reader->dump.save(ctx, filename, reader->dump.user_data)
+                                   : save_game_dump_with_style(ctx, filename, reader->dump.style);
+    if (result != 0 && reader->stats->dump_failures++ == 0) {
+        snprintf(reader->stats->failed_dump, sizeof(reader->stats->failed_dump), "%s", filename);
+    }
+    return result;
+}
+
+static void batch_discard_events(GameContext* ctx, void* user_data) {
+    (void)user_data;
+    event_log_clear(&ctx->events);
+}
+
+static void batch_ignore_game_over(GameContext* ctx, void* user_data) {
+    (void)ctx;
+    (void)user_data;
+}
+
+// 与终端相同的开局：优先使用预设，没有预设时从脚本读取初始资金和角色
+static BatchResult batch_setup(GameContext* ctx, const char* preset_file, BatchStats* stats) {
+    const char* file_to_load = preset_file ? preset_file : "preset.json";
+    char* preset_text = read_text_file(file_to_load, NULL);
+    if (preset_text) {
+        int result = load_game_from_json(ctx, preset_text, &stats->preset_error);
+        free(preset_text);
+        // 终端会退回交互设置，批处理直接报错，以免把后面的命令当成角色选择
+        return result == 0 ? BATCH_OK : BATCH_PRESET_ERROR;
+    }
+
+    int initial_fund = get_initial_fund(ctx);
+    show_welcome_and_select_character(ctx, initial_fund);
+    return ctx->state.player_count > 0 ? BATCH_OK : BATCH_NO_PLAYERS;
+}
+
+BatchResult run_batch_script(GameContext* ctx, const char* script_file,
+                             const char* preset_file, BatchStats* stats) {
+    memset(stats, 0, sizeof(*stats));
+
+    FILE* script = fopen(script_file, "r");
+    if (!script) {
+        return BATCH_SCRIPT_ERROR;
+    }
+
+    ctx->events.verbosity = VERBOSITY_QUIET;
+
+    BatchReader reader = { script, stats, ctx->io.dump };
+    ctx->io.read_prompt = batch_prompt_answer;
+    ctx->io.echo_prompts = false;
+    ctx->io.user_data = &reader;
+    ctx->io.dump.save = batch_save_dump;
+    ctx->io.dump.user_data = &reader;
+
+    BatchResult result = batch_setup(ctx, preset_file, stats);
+    if (result == BATCH_OK) {
+        TurnHooks hooks = { batch_discard_events, batch_ignore_game_over, NULL };
+        // 与终端输入缓冲一致，命令最长 99 字节
+        char command[100];
+
+        advance_to_next_command(ctx, &hooks);
+        while (fgets(command, sizeof(command), script) != NULL) {
+            command[strcspn(command, "\n")] = 0;
+
+            process_command(ctx, command);
+            stats->commands++;
+            if (ctx->quit_requested) {
+                stats->quit = true;
+                break;
+            }
+            advance_to_next_command(ctx, &hooks);
+        }
+    }
+
+    event_log_clear(&ctx->events);
+    ctx->io.read_prompt = NULL;
+    ctx->io.echo_prompts = true;
+    ctx->io.user_data = NULL;
+    ctx->io.dump = reader.dump;
+    fclose(script);
+    if (result == BATCH_OK && stats->dump_failures > 0) {
+        result = BATCH_DUMP_ERROR;
+    }
+    return result;
+}
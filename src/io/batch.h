@@ -0,0 +1,37 @@
+#ifndef BATCH_H
+#define BATCH_H
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include "../game/game_context.h"
+#include "../utils/json_reader.h"
+
+// 批处理模式：从脚本文件依次读取命令和交互应答，不绘制地图、不输出提示
+// 脚本格式与终端的标准输入完全相同（每行一条，交互应答紧跟在触发它的命令之后）
+
+typedef enum {
+    BATCH_OK = 0,
+    BATCH_SCRIPT_ERROR,   // 无法读取脚本文件
+    BATCH_PRESET_ERROR,   // 预设文件存在但格式错误
+    BATCH_NO_PLAYERS,     // 脚本中的角色选择没有产生任何玩家
+    BATCH_DUMP_ERROR      // 脚本运行完毕，但其中的 dump 命令有保存失败的
+} BatchResult;
+
+typedef struct {
+    uint64_t commands;        // 执行的命令数
+    uint64_t prompts;         // 从脚本读取的交互应答数（含开局设置）
+    bool quit;                // 脚本以 quit 结束
+    JsonError preset_error;   // BATCH_PRESET_ERROR 时的出错位置
+    uint64_t dump_failures;   // 保存失败的 dump 命令数
+    char failed_dump[256];    // 第一个保存失败的文件名
+} BatchStats;
+
+// 在已初始化的上下文上运行脚本（调用方负责 game_context_init，并可安装存档钩子，
+// 钩子返回非 0 即算作保存失败）
+// preset_file 为 NULL 时与终端一样尝试 preset.json，
+// 预设文件不存在时开局设置（初始资金、角色）也从脚本读取
+BatchResult run_batch_script(GameContext* ctx, const char* script_file,
+                             const char* preset_file, BatchStats* stats);
+
+#endif // BATCH_H
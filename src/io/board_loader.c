@@ -0,0 +1,254 @@
+#include "board_loader.h"
+#include "json_serializer.h"
+#include "../utils/json_reader.h"
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+typedef struct {
+    const char* name;
+    TileKind kind;
+    char symbol; // 未给出 symbol 时的默认地图字符
+} TileKindName;
+
+static const TileKindName s_kind_names[] = {
+    { "land", TILE_LAND, '0' },
+    { "start", TILE_START, 'S' },
+    { "park", TILE_PARK, 'P' },
+    { "prop_shop", TILE_PROP_SHOP, 'T' },
+    { "gift_house", TILE_GIFT_HOUSE, 'G' },
+    { "mine", TILE_MINE, '$' },
+};
+
+typedef struct {
+    const JsonDocument* doc;
+    char* error;
+    size_t error_size;
+} BoardParser;
+
+static int fail(BoardParser* parser, const char* format, ...) {
+    va_list args;
+    va_start(args, format);
+    vsnprintf(parser->error, parser->error_size, format, args);
+    va_end(args);
+    return -1;
+}
+
+// 读取可选的整数字段：不存在时保留 *value 原值，类型不对返回 false
+static bool read_int(const BoardParser* parser, const JsonNode* object, const char* key, int* value) {
+    const JsonNode* node = json_member(parser->doc, object, key);
+    if (!node) {
+        return true;
+    }
+    if (node->type != JSON_NUMBER) {
+        return false;
+    }
+    *value = atoi(node->text);
+    return true;
+}
+
+static bool read_string(const BoardParser* parser, const JsonNode* object, const char* key, char* buffer, size_t size) {
+    const JsonNode* node = json_member(parser->doc, object, key);
+    if (!node) {
+        return true;
+    }
+    return json_string_copy(node, buffer, size);
+}
+
+static const TileKindName* find_kind(const char* name) {
+    for (size_t i = 0; i < sizeof(s_kind_names) / sizeof(s_kind_names[0]); i++) {
+        if (strcmp(s_kind_names[i].name, name) == 0) {
+            return &s_kind_names[i];
+        }
+    }
+    return NULL;
+}
+
+static int parse_district_prices(BoardParser* parser, Board* board, const JsonNode* root) {
+    // 缺省与经典地图相同
+    memcpy(board->district_price, board_classic()->district_price, sizeof(board->district_price));
+
+    const JsonNode* prices = json_member(parser->doc, root, "district_prices");
+    if (!prices) {
+        return 0;
+    }
+    if (prices->type != JSON_ARRAY) {
+        return fail(parser, "district_prices 必须是数组");
+    }
+    int district = 1;
+    for (const JsonNode* item = json_first(parser->doc, prices); item; item = json_next(parser->doc, item)) {
+        if (district > DISTRICT_COUNT) {
+            return fail(parser, "地段数不能超过 %d", DISTRICT_COUNT);
+        }
+        if (item->type != JSON_NUMBER || atoi(item->text) < 0) {
+            return fail(parser, "地段 %d 的地价无效", district);
+        }
+        board->district_price[district++] = atoi(item->text);
+    }
+    return 0;
+}
+
+static int parse_tile(BoardParser* parser, Board* board, int location, const JsonNode* item) {
+    if (item->type != JSON_OBJECT) {
+        return fail(parser, "第 %d 格必须是对象", location);
+    }
+
+    char type[32] = "";
+    if (!read_string(parser, item, "type", type, sizeof(type)) || !type[0]) {
+        return fail(parser, "第 %d 格缺少 type", location);
+    }
+    const TileKindName* kind = find_kind(type);
+    if (!kind) {
+        return fail(parser, "第 %d 格的类型未知: %s", location, type);
+    }
+
+    Tile* tile = &board->tiles[location];
+    tile->kind = (unsigned char)kind->kind;
+    tile->symbol = kind->symbol;
+    tile->district = 0;
+    tile->price = 0;
+    tile->credit = 0;
+
+    char symbol[8] = "";
+    if (!read_string(parser, item, "symbol", symbol, sizeof(symbol)) || (symbol[0] && symbol[1])) {
+        return fail(parser, "第 %d 格的 symbol 必须是单个字符", location);
+    }
+    if (symbol[0]) {
+        tile->symbol = symbol[0];
+    }
+
+    if (kind->kind == TILE_LAND) {
+        int district = 0;
+        if (!read_int(parser, item, "district", &district) || district < 1 || district > DISTRICT_COUNT) {
+            return fail(parser, "第 %d 格的 district 必须在 1 到 %d 之间", location, DISTRICT_COUNT);
+        }
+        int price = board->district_price[district];
+        if (!read_int(parser, item, "price", &price) || price < 0) {
+            return fail(parser, "第 %d 格的 price 无效", location);
+        }
+        tile->district = (unsigned char)district;
+        tile->price = price;
+    } else if (kind->kind == TILE_MINE) {
+        int credit = 0;
+        if (!read_int(parser, item, "credit", &credit) || credit < 0) {
+            return fail(parser, "第 %d 格的 credit 无效", location);
+        }
+        tile->credit = credit;
+    }
+    return 0;
+}
+
+static int parse_display(BoardParser* parser, Board* board, const JsonNode* display) {
+    if (display->type != JSON_OBJECT) {
+        return fail(parser, "display 必须是对象");
+    }
+    int rows = 0;
+    int cols = 0;
+    if (!read_int(parser, display, "rows", &rows) || !read_int(parser, display, "cols", &cols) ||
+        rows < 1 || rows > BOARD_MAX_ROWS || cols < 1 || cols > BOARD_MAX_COLS) {
+        return fail(parser, "display 的尺寸必须在 %dx%d 以内", BOARD_MAX_ROWS, BOARD_MAX_COLS);
+    }
+    board->side_label_row = -1;
+    if (!read_string(parser, display, "header", board->header, sizeof(board->header)) ||
+        !read_string(parser, display, "footer", board->footer, sizeof(board->footer)) ||
+        !read_string(parser, display, "side_label", board->side_label, sizeof(board->side_label)) ||
+        !read_int(parser, display, "side_label_row", &board->side_label_row)) {
+        return fail(parser, "display 的标注格式错误");
+    }
+    board->rows = rows;
+    board->cols = cols;
+    return 0;
+}
+
+// 按各格的 row/col 建立位置与显示格子的双向映射
+static int parse_layout(BoardParser* parser, Board* board, const JsonNode* tiles) {
+    for (int c = 0; c < board->rows * board->cols; c++) {
+        board->cell_occupant[c] = -1;
+        board->cell_tile[c] = -1;
+        board->cell_base[c] = ' ';
+    }
+
+    int location = 0;
+    for (const JsonNode* item = json_first(parser->doc, tiles); item; item = json_next(parser->doc, item)) {
+        int row = -1;
+        int col = -1;
+        if (!read_int(parser, item, "row", &row) || !read_int(parser, item, "col", &col) ||
+            row < 0 || row >= board->rows || col < 0 || col >= board->cols) {
+            return fail(parser, "第 %d 格的显示坐标无效", location);
+        }
+        int cell = row * board->cols + col;
+        if (board->cell_tile[cell] != -1) {
+            return fail(parser, "第 %d 格与第 %d 格的显示坐标重叠", location, board->cell_tile[cell]);
+        }
+        board->tile_cell[location] = cell;
+        board->cell_occupant[cell] = location;
+        board->cell_tile[cell] = location;
+        board->cell_base[cell] = board->tiles[location].symbol;
+        location++;
+    }
+    return 0;
+}
+
+static int parse_board(BoardParser* parser, Board* board, const JsonNode* root) {
+    if (root->type != JSON_OBJECT) {
+        return fail(parser, "地图文件的根必须是对象");
+    }
+    if (!read_string(parser, root, "name", board->name, sizeof(board->name))) {
+        return fail(parser, "name 必须是字符串");
+    }
+    if (parse_district_prices(parser, board, root) != 0) {
+        return -1;
+    }
+
+    const JsonNode* tiles = json_member(parser->doc, root, "tiles");
+    if (!tiles || tiles->type != JSON_ARRAY) {
+        return fail(parser, "缺少 tiles 数组");
+    }
+    int location = 0;
+    for (const JsonNode* item = json_first(parser->doc, tiles); item; item = json_next(parser->doc, item)) {
+        if (location >= MAX_MAP_SIZE) {
+            return fail(parser, "格子数不能超过 %d", MAX_MAP_SIZE);
+        }
+        if (parse_tile(parser, board, location, item) != 0) {
+            return -1;
+        }
+        board->tile_cell[location] = -1;
+        location++;
+    }
+    if (location < 2) {
+        return fail(parser, "地图至少需要 2 格");
+    }
+    board->size = location;
+
+    const JsonNode* display = json_member(parser->doc, root, "display");
+    if (display) {
+        if (parse_display(parser, board, display) != 0 || parse_layout(parser, board, tiles) != 0) {
+            return -1;
+        }
+    }
+    return 0;
+}
+
+int board_load(Board* board, const char* filename, char* error, size_t error_size) {
+    BoardParser parser = { NULL, error, error_size };
+
+    char* content = read_text_file(filename, NULL);
+    if (!content) {
+        return fail(&parser, "无法读取文件");
+    }
+
+    JsonDocument doc;
+    JsonError json_error;
+    if (!json_parse(&doc, content, &json_error)) {
+        free(content);
+        return fail(&parser, "第 %d 行第 %d 列: %s", json_error.line, json_error.column, json_error.message);
+    }
+
+    memset(board, 0, sizeof(*board));
+    parser.doc = &doc;
+    int result = parse_board(&parser, board, &doc.nodes[0]);
+    json_free(&doc);
+    free(content);
+    return result;
+}
@@ -0,0 +1,26 @@
+#ifndef BOARD_LOADER_H
+#define BOARD_LOADER_H
+
+#include "../game/board.h"
+#include <stddef.h>
+
+// 从 JSON 文件加载地图，成功返回 0；失败时把原因写入 error
+//
+// {
+//   "name": "...",
+//   "district_prices": [200, 500, 300],        地段 1..N 的默认地价，可省略（取经典地图的地价）
+//   "display": { "rows": 8, "cols": 29,        可省略，省略时不绘制地图
+//                "header": "...", "footer": "...", "side_label": "...", "side_label_row": 3 },
+//   "tiles": [                                 按位置顺序，至少 2 格
+//     { "type": "start", "row": 0, "col": 0 },
+//     { "type": "land", "district": 1, "price": 200, "row": 0, "col": 1 },
+//     { "type": "mine", "credit": 60, "symbol": "$", "row": 1, "col": 0 }
+//   ]
+// }
+//
+// type 为 start/land/park/prop_shop/gift_house/mine；land 必须给出 district，
+// price 缺省取所在地段的默认地价；symbol 缺省按类型取 S/0/P/T/G/$；
+// 有 display 时每格都要给出 row/col，且不能重叠
+int board_load(Board* board, const char* filename, char* error, size_t error_size);
+
+#endif // BOARD_LOADER_H
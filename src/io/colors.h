@@ -1,23 +1,11 @@
 #ifndef COLORS_H
 #define COLORS_H
 
-#include <stdlib.h>
-#include <string.h>
+#include "output.h"
 
-// 检测终端是否支持ANSI转义序列
+// 是否输出 ANSI 转义序列由当前输出后端决定（终端能力在启动时检测一次）
 static inline int supports_ansi() {
-    const char* term = getenv("TERM");
-    if (!term) return 0;
-    
-    // 检查是否为不支持ANSI的终端类型
-    if (strcmp(term, "dumb") == 0) return 0;
-    if (strcmp(term, "unknown") == 0) return 0;
-    
-    // 检查是否明确禁用了颜色
-    const char* no_color = getenv("NO_COLOR");
-    if (no_color && strlen(no_color) > 0) return 0;
-    
-    return 1;
+    return output_ansi_enabled();
 }
 
 // 条件性颜色定义
@@ -6,8 +6,15 @@
 #include "../game/land.h"
 #include "../game/block_system.h"
 #include "../game/god_system.h"
+#include "../game/ownership.h"
+#include "../game/movement.h"
 #include "../io/colors.h"
 #include "json_serializer.h"
+#include "snapshot.h"
+#include "event_text.h"
+#include "renderer.h"
+#include "journal.h"
+#include "command_registry.h"
 #include "utils.h"
 #include <stdio.h>
 #include <stdlib.h>
@@ -16,362 +23,258 @@
 #include <time.h>
 #include <ctype.h>
 
-// 全局消息缓冲区
-char g_last_action_message[1024] = {0};
-
 // 函数声明
-void handle_roll_command();
-void handle_step_command(const char* command);
-void handle_query_command();
-void handle_help_command();
-void handle_quit_command();
-void handle_sell_command(int location);
-void switch_to_next_player(bool should_update_god);
+void handle_roll_command(GameContext* ctx);
+void handle_step_command(GameContext* ctx, int steps);
+void handle_query_command(GameContext* ctx);
+void handle_help_command(GameContext* ctx);
+void handle_quit_command(GameContext* ctx);
+void handle_sell_command(GameContext* ctx, int location);
+void switch_to_next_player(GameContext* ctx, bool should_update_god);
 
 
-void process_command(const char* command) {
-    // 不再在这里清空消息，而是在消息显示后清空
-    char message_buffer[1024] = {0};
+// ---- 内置命令 ----
+
+static Player* current_player_of(GameContext* ctx) {
+    return &ctx->state.players[ctx->state.game.now_player_id];
+}
+
+static void cmd_roll(GameContext* ctx, const CommandArgs* args) {
+    (void)args;
+    handle_roll_command(ctx);
+}
+
+static void cmd_step(GameContext* ctx, const CommandArgs* args) {
+    // 支持负数步数：正数向前移动，负数向后移动
+    handle_step_command(ctx, args->items[0].value);
+}
+
+static void cmd_query(GameContext* ctx, const CommandArgs* args) {
+    (void)args;
+    handle_query_command(ctx);
+}
+
+static void cmd_help(GameContext* ctx, const CommandArgs* args) {
+    (void)args;
+    handle_help_command(ctx);
+}
+
+static void cmd_sell(GameContext* ctx, const CommandArgs* args) {
+    handle_sell_command(ctx, args->items[0].value);
+}
+
+static void cmd_block(GameContext* ctx, const CommandArgs* args) {
+    handle_block_command(ctx, current_player_of(ctx), args->items[0].value);
+}
+
+static void cmd_robot(GameContext* ctx, const CommandArgs* args) {
+    (void)args;
+    handle_robot_command(ctx, current_player_of(ctx));
+}
 
-    char lower_command[100];
-    for (int i = 0; command[i]; i++) {
-        lower_command[i] = tolower(command[i]);
+static void cmd_quit(GameContext* ctx, const CommandArgs* args) {
+    (void)args;
+    handle_quit_command(ctx);
+}
+
+static void cmd_create_player(GameContext* ctx, const CommandArgs* args) {
+    // 简单的创建玩家命令: create_player 张三 1500
+    char name[MAX_NAME_LENGTH];
+    command_arg_copy(&args->items[0], name, sizeof(name));
+    // 交互对局的座位数与预设角色数相同，更多玩家只在模拟中使用
+    Player* p = NULL;
+    if (ctx->state.player_count < PRESET_CHARACTER_COUNT) {
+        p = create_player(ctx, ctx->state.player_count, name, args->items[1].value);
     }
-    lower_command[strlen(command)] = '\0';
-
-    if (strcmp(lower_command, "roll") == 0) {
-        handle_roll_command();
-    } else if (strncmp(lower_command, "step", 4) == 0) {
-        handle_step_command(lower_command);
-    } else if (strcmp(lower_command, "query") == 0) {
-        handle_query_command();
-    } else if (strcmp(lower_command, "help") == 0) {
-        handle_help_command();
-    } else if (strncmp(lower_command, "sell ", 5) == 0) {
-        int location;
-        if (sscanf(command, "sell %d", &location) == 1) {
-            handle_sell_command(location);
-        } else {
-            snprintf(message_buffer, sizeof(message_buffer), "格式错误，请使用: sell <位置>\n");
-        }
-    } else if (strncmp(lower_command, "block ", 6) == 0) {
-        int relative_distance;
-        if (sscanf(command, "block %d", &relative_distance) == 1) {
-            Player* current_player = &g_game_state.players[g_game_state.game.now_player_id];
-            handle_block_command(current_player, relative_distance);
-        } else {
-            snprintf(message_buffer, sizeof(message_buffer), "格式错误，请使用: block <相对距离>\n");
-        }
-    } else if (strcmp(lower_command, "robot") == 0) {
-        Player* current_player = &g_game_state.players[g_game_state.game.now_player_id];
-        handle_robot_command(current_player);
-    } else if (strcmp(lower_command, "quit") == 0) {
-        handle_quit_command();
-    } else if (strncmp(lower_command, "create_player", 13) == 0) {
-        // 简单的创建玩家命令: create_player 张三 1500
-        char name[32];
-        int fund;
-        if (sscanf(command, "create_player %s %d", name, &fund) == 2) {
-            Player* p = create_player(g_game_state.player_count, name, fund);
-            if (p) {
-                snprintf(message_buffer, sizeof(message_buffer), "创建玩家成功: %s\n", p->name);
-            } else {
-                snprintf(message_buffer, sizeof(message_buffer), "创建玩家失败\n");
-            }
-        } else {
-            snprintf(message_buffer, sizeof(message_buffer), "格式错误，请使用: create_player <姓名> <资金>\n");
-        }
-    } else if (strcmp(lower_command, "status") == 0) {
-        print_game_state();
-    } else if (strcmp(lower_command, "dump") == 0) {
-        // dump命令: 默认保存为dump.json
-        save_game_dump("dump.json");
-        snprintf(message_buffer, sizeof(message_buffer), "游戏状态已保存到: dump.json\n");
-    } else if (strncmp(lower_command, "dump ", 5) == 0) {
-        // dump命令: dump filename.json (带文件名)
-        char filename[256];
-        if (sscanf(command, "dump %s", filename) == 1) {
-            save_game_dump(filename);
-            snprintf(message_buffer, sizeof(message_buffer), "游戏状态已保存到: %s\n", filename);
-        } else {
-            snprintf(message_buffer, sizeof(message_buffer), "格式错误，请使用: dump 或 dump <文件名>\n");
-        }
-    } else if (strncmp(lower_command, "load", 4) == 0) {
-        // load命令: load filename.json
-        char filename[256];
-        if (sscanf(command, "load %s", filename) == 1) {
-            if (load_game_preset(filename) == 0) {
-                snprintf(message_buffer, sizeof(message_buffer), "游戏状态已从 %s 加载\n", filename);
-            } else {
-                snprintf(message_buffer, sizeof(message_buffer), "加载失败: %s\n", filename);
-            }
-        } else {
-            snprintf(message_buffer, sizeof(message_buffer), "格式错误，请使用: load <文件名>\n");
-        }
+    if (p) {
+        emit_event1(ctx, EVT_PLAYER_CREATED, player_slot(ctx, p));
     } else {
-        snprintf(message_buffer, sizeof(message_buffer), "未知命令: %s\n", command);
-        handle_help_command();
+        emit_event(ctx, EVT_PLAYER_CREATE_FAILED);
     }
+}
+
+static void cmd_status(GameContext* ctx, const CommandArgs* args) {
+    (void)args;
+    print_game_state(ctx);
+}
 
-    // 如果有消息，则拼接到全局消息缓冲区
-    if (strlen(message_buffer) > 0) {
-        strncat(g_last_action_message, message_buffer, sizeof(g_last_action_message) - strlen(g_last_action_message) - 1);
+static void cmd_dump(GameContext* ctx, const CommandArgs* args) {
+    // dump命令: 默认保存为dump.json，也可以带文件名
+    char filename[256] = "dump.json";
+    if (args->count > 0) {
+        command_arg_copy(&args->items[0], filename, sizeof(filename));
     }
+    int result = ctx->io.dump.save ? ctx->io.dump.save(ctx, filename, ctx->io.dump.user_data)
+                                   : save_game_dump_with_style(ctx, filename, ctx->io.dump.style);
+    emit_event_text(ctx, result == 0 ? EVT_DUMP_SAVED : EVT_DUMP_FAILED, filename);
 }
 
-void handle_roll_command() {
-    Player* current_player = &g_game_state.players[g_game_state.game.now_player_id];
-    char message_buffer[256];
-    
-    int steps = rand() % 6 + 1;
-    snprintf(message_buffer, sizeof(message_buffer), "玩家 %s 掷骰子，点数为 %d\n", current_player->name, steps);
-    strncat(g_last_action_message, message_buffer, sizeof(g_last_action_message) - strlen(g_last_action_message) - 1);
-    
-    int original_location = current_player->location;
-    int final_location = (original_location + steps) % MAP_SIZE;
-    int final_steps = steps;
-    bool stopped_by_block = false;
-    
-    // 检查移动路径上是否有路障或财神
-    for (int i = 1; i <= steps; i++) {
-        int next_location = (original_location + i) % MAP_SIZE;
-        
-        // 检查路障拦截
-        if (check_block_interception(next_location)) {
-            final_location = next_location;
-            final_steps = i;
-            stopped_by_block = true;
-            break; // 找到第一个路障就停下
-        }
+static void cmd_load(GameContext* ctx, const CommandArgs* args) {
+    // load命令: load filename.json（也接受二进制快照）
+    char filename[256];
+    command_arg_copy(&args->items[0], filename, sizeof(filename));
+    int loaded = is_snapshot_file(filename) ? load_game_snapshot(ctx, filename)
+                                            : load_game_preset(ctx, filename);
+    if (loaded == 0) {
+        emit_event_text(ctx, EVT_LOADED, filename);
+    } else {
+        emit_event_text(ctx, EVT_LOAD_FAILED, filename);
+    }
+}
 
-        // 检查是否遇到财神
-        if (check_god_encounter(next_location)) {
-            // 遇到财神不停下，直接触发效果
-            trigger_god_encounter(current_player, next_location);
-        }
+// step、create_player、load 沿用旧的写法，参数可以紧跟命令名；
+// 其余带参数的命令必须以空白分隔，否则按未知命令处理
+static const CommandSpec s_builtin_commands[] = {
+    { "block", 1, { COMMAND_ARG_INT }, false, false, EVT_BLOCK_FORMAT_ERROR, false, cmd_block },
+    { "create_player", 2, { COMMAND_ARG_WORD, COMMAND_ARG_INT }, false, true, EVT_CREATE_PLAYER_FORMAT_ERROR, false, cmd_create_player },
+    { "dump", 1, { COMMAND_ARG_WORD }, true, false, EVT_DUMP_FORMAT_ERROR, false, cmd_dump },
+    { "help", 0, { COMMAND_ARG_INT }, false, false, EVT_NONE, false, cmd_help },
+    { "load", 1, { COMMAND_ARG_WORD }, false, true, EVT_LOAD_FORMAT_ERROR, false, cmd_load },
+    { "query", 0, { COMMAND_ARG_INT }, false, false, EVT_NONE, false, cmd_query },
+    { "quit", 0, { COMMAND_ARG_INT }, false, false, EVT_NONE, false, cmd_quit },
+    { "robot", 0, { COMMAND_ARG_INT }, false, false, EVT_NONE, false, cmd_robot },
+    { "roll", 0, { COMMAND_ARG_INT }, false, false, EVT_NONE, false, cmd_roll },
+    { "sell", 1, { COMMAND_ARG_INT }, false, false, EVT_SELL_FORMAT_ERROR, false, cmd_sell },
+    { "status", 0, { COMMAND_ARG_INT }, false, false, EVT_NONE, false, cmd_status },
+    { "step", 1, { COMMAND_ARG_INT }, false, true, EVT_STEP_FORMAT_ERROR, true, cmd_step },
+};
+
+void register_builtin_commands(void) {
+    // 同名命令注册时直接替换，重复调用不会产生重复项
+    for (size_t i = 0; i < sizeof(s_builtin_commands) / sizeof(s_builtin_commands[0]); i++) {
+        command_register(&s_builtin_commands[i]);
     }
-    
-    // 如果是被路障拦截，在移动和触发地点事件前，先触发路障效果
-    if (stopped_by_block) {
-        trigger_block_interception(current_player, final_location);
+}
+
+void process_command(GameContext* ctx, const char* command) {
+    // 先写日志再执行，quit 等命令执行后不会再回到这里
+    if (ctx->io.journal) {
+        journal_record_command(ctx->io.journal, ctx->rng.draws, command);
+    }
+
+    // 不再在这里清空消息，而是在消息显示后清空
+    if (command_execute(ctx, command) == COMMAND_NOT_FOUND) {
+        // 帮助信息会覆盖之前的消息，未知命令提示排在其后
+        handle_help_command(ctx);
+        emit_event_text(ctx, EVT_UNKNOWN_COMMAND, command);
     }
+}
 
-    // 移动到最终位置
-    current_player->location = final_location;
-    snprintf(message_buffer, sizeof(message_buffer), "%s 前进 %d 步，到达位置 %d\n", current_player->name, final_steps, current_player->location);
-    strncat(g_last_action_message, message_buffer, sizeof(g_last_action_message) - strlen(g_last_action_message) - 1);
+void handle_roll_command(GameContext* ctx) {
+    Player* current_player = &ctx->state.players[ctx->state.game.now_player_id];
+    
+    int steps = game_rand_below(ctx, 6) + 1;
+    emit_event2(ctx, EVT_ROLL, player_slot(ctx, current_player), steps);
+    
+    // 途经财神直接触发；被路障拦截时先触发路障效果，再移动和触发地点事件
+    MovePlan plan = plan_move(ctx, current_player->location, steps);
+    execute_move(ctx, current_player, &plan, INTERCEPT_BEFORE_LANDING);
 
     // 不在这里触发事件，只标记需要交互
-    g_game_state.game.interaction_pending = true;
+    ctx->state.game.interaction_pending = true;
 
     // 切换到下一个玩家（游戏未结束时）
-    if (!g_game_state.game.ended) {
-        switch_to_next_player(false); // 移动完成，但交互可能还未完成，暂不更新财神状态
+    if (!ctx->state.game.ended) {
+        switch_to_next_player(ctx, false); // 移动完成，但交互可能还未完成，暂不更新财神状态
     }
 }
 
-void handle_step_command(const char* command) {
-    int steps;
-    if (sscanf(command, "step %d", &steps) == 1) {
-        // 支持负数步数：正数向前移动，负数向后移动
-        
-        Player* current_player = &g_game_state.players[g_game_state.game.now_player_id];
-        char message_buffer[256];
-        
-        snprintf(message_buffer, sizeof(message_buffer), "遥控骰子，指定步数为 %d\n", steps);
-        strncat(g_last_action_message, message_buffer, sizeof(g_last_action_message) - strlen(g_last_action_message) - 1);
-
-        int original_location = current_player->location;
-        int final_location, final_steps;
-        bool stopped_by_block = false;
-        
-        // 处理负数步数：向后移动
-        if (steps < 0) {
-            // 负数步数：向后移动
-            int abs_steps = -steps;
-            final_location = (original_location - abs_steps + MAP_SIZE) % MAP_SIZE;
-            final_steps = steps;
-            
-            // 检查移动路径上是否有路障或财神（向后移动）
-            for (int i = 1; i <= abs_steps; i++) {
-                int next_location = (original_location - i + MAP_SIZE) % MAP_SIZE;
-                
-                // 检查路障拦截
-                if (check_block_interception(next_location)) {
-                    final_location = next_location;
-                    final_steps = -i;
-                    stopped_by_block = true;
-                    break; // 找到第一个路障就停下
-                }
-
-                // 检查是否遇到财神
-                if (check_god_encounter(next_location)) {
-                    // 遇到财神不停下，直接触发效果
-                    trigger_god_encounter(current_player, next_location);
-                }
-            }
-        } else {
-            // 正数步数：向前移动（原有逻辑）
-            final_location = (original_location + steps) % MAP_SIZE;
-            final_steps = steps;
-            
-            // 检查移动路径上是否有路障或财神（向前移动）
-            for (int i = 1; i <= steps; i++) {
-                int next_location = (original_location + i) % MAP_SIZE;
-                
-                // 检查路障拦截
-                if (check_block_interception(next_location)) {
-                    final_location = next_location;
-                    final_steps = i;
-                    stopped_by_block = true;
-                    break; // 找到第一个路障就停下
-                }
+void handle_step_command(GameContext* ctx, int steps) {
+    Player* current_player = &ctx->state.players[ctx->state.game.now_player_id];
+    
+    emit_event1(ctx, EVT_REMOTE_DICE, steps);
 
-                // 检查是否遇到财神
-                if (check_god_encounter(next_location)) {
-                    // 遇到财神不停下，直接触发效果
-                    trigger_god_encounter(current_player, next_location);
-                }
-            }
-        }
-        
-        // 移动到最终位置
-        current_player->location = final_location;
-        if (final_steps < 0) {
-            snprintf(message_buffer, sizeof(message_buffer), "%s 后退 %d 步，到达位置 %d\n", current_player->name, -final_steps, current_player->location);
-        } else {
-            snprintf(message_buffer, sizeof(message_buffer), "%s 前进 %d 步，到达位置 %d\n", current_player->name, final_steps, current_player->location);
-        }
-        strncat(g_last_action_message, message_buffer, sizeof(g_last_action_message) - strlen(g_last_action_message) - 1);
-        
-        // 如果是被路障拦截，在移动后触发路障效果
-        if (stopped_by_block) {
-            trigger_block_interception(current_player, final_location);
-        }
-        
-        // 不在这里触发事件，只标记需要交互，并记录执行交互的玩家ID
-        g_game_state.game.interaction_pending = true;
-        g_game_state.game.pending_interaction_player_id = g_game_state.game.now_player_id;
+    // 负数步数向后移动；被路障拦截时在移动后触发路障效果
+    MovePlan plan = plan_move(ctx, current_player->location, steps);
+    execute_move(ctx, current_player, &plan, INTERCEPT_AFTER_LANDING);
+    
+    // 不在这里触发事件，只标记需要交互，并记录执行交互的玩家ID
+    ctx->state.game.interaction_pending = true;
+    ctx->state.game.pending_interaction_player_id = ctx->state.game.now_player_id;
+    
+    // 切换到下一个玩家（游戏未结束时）
+    if (!ctx->state.game.ended) {
+        switch_to_next_player(ctx, false); // 移动完成，但交互可能还未完成，暂不更新财神状态
         
-        // 切换到下一个玩家（游戏未结束时）
-        if (!g_game_state.game.ended) {
-            switch_to_next_player(false); // 移动完成，但交互可能还未完成，暂不更新财神状态
-            
-            // 根据图片规则：财神状态应该在回合结束时更新
-            // 当轮到第一个玩家时，表示新一轮开始，更新财神状态
-            if (g_game_state.game.now_player_id == 0) {
-                update_god_status();
-            }
+        // 根据图片规则：财神状态应该在回合结束时更新
+        // 当轮到第一个玩家时，表示新一轮开始，更新财神状态
+        if (ctx->state.game.now_player_id == 0) {
+            update_god_status(ctx);
         }
-    } else {
-        snprintf(g_last_action_message, sizeof(g_last_action_message), "无效的 step 命令格式, e.g., step 5\n");
     }
 }
 
-void handle_query_command() {
-    Player* p = &g_game_state.players[g_game_state.game.now_player_id];
-    char buffer[1024] = {0};
-    char line[256];
-
-    strncat(buffer, "资产查询:\n", sizeof(buffer) - strlen(buffer) - 1);
-    snprintf(line, sizeof(line), "  玩家: %s\n", p->name);
-    strncat(buffer, line, sizeof(buffer) - strlen(buffer) - 1);
-    snprintf(line, sizeof(line), "  资金: %d 元\n", p->fund);
-    strncat(buffer, line, sizeof(buffer) - strlen(buffer) - 1);
-    snprintf(line, sizeof(line), "  点数: %d 点\n", p->credit);
-    strncat(buffer, line, sizeof(buffer) - strlen(buffer) - 1);
-    snprintf(line, sizeof(line), "  位置: %d\n", p->location);
-    strncat(buffer, line, sizeof(buffer) - strlen(buffer) - 1);
-    strncat(buffer, "  道具:\n", sizeof(buffer) - strlen(buffer) - 1);
-    snprintf(line, sizeof(line), "    - 路障: %d\n", p->prop.barrier);
-    strncat(buffer, line, sizeof(buffer) - strlen(buffer) - 1);
-    snprintf(line, sizeof(line), "    - 机器娃娃: %d\n", p->prop.robot);
-    strncat(buffer, line, sizeof(buffer) - strlen(buffer) - 1);
-    strncat(buffer, "  状态:\n", sizeof(buffer) - strlen(buffer) - 1);
+void handle_query_command(GameContext* ctx) {
+    Player* p = &ctx->state.players[ctx->state.game.now_player_id];
+
+    // 查询结果覆盖之前的消息
+    event_log_clear(&ctx->events);
+    emit_event(ctx, EVT_QUERY_HEADER);
+    emit_event1(ctx, EVT_QUERY_PLAYER, player_slot(ctx, p));
+    emit_event1(ctx, EVT_QUERY_FUND, p->fund);
+    emit_event1(ctx, EVT_QUERY_CREDIT, p->credit);
+    emit_event1(ctx, EVT_QUERY_LOCATION, p->location);
+    emit_event(ctx, EVT_QUERY_PROPS);
+    emit_event1(ctx, EVT_QUERY_BARRIER, p->prop.barrier);
+    emit_event1(ctx, EVT_QUERY_ROBOT, p->prop.robot);
+    emit_event(ctx, EVT_QUERY_STATUS);
     bool has_status = false;
     if (p->buff.god > 0) {
-        snprintf(line, sizeof(line), "    - 财神附身: 剩余 %d 回合\n", p->buff.god);
-        strncat(buffer, line, sizeof(buffer) - strlen(buffer) - 1);
+        emit_event1(ctx, EVT_QUERY_GOD_BUFF, p->buff.god);
         has_status = true;
     }
     if (p->buff.prison > 0) {
-        snprintf(line, sizeof(line), "    - 监狱: 剩余 %d 回合\n", p->buff.prison);
-        strncat(buffer, line, sizeof(buffer) - strlen(buffer) - 1);
+        emit_event1(ctx, EVT_QUERY_PRISON, p->buff.prison);
         has_status = true;
     }
     if (p->buff.hospital > 0) {
-        snprintf(line, sizeof(line), "    - 医院: 剩余 %d 回合\n", p->buff.hospital);
-        strncat(buffer, line, sizeof(buffer) - strlen(buffer) - 1);
+        emit_event1(ctx, EVT_QUERY_HOSPITAL, p->buff.hospital);
         has_status = true;
     }
     if (!has_status) {
-        strncat(buffer, "    - (无特殊状态)\n", sizeof(buffer) - strlen(buffer) - 1);
+        emit_event(ctx, EVT_QUERY_NO_STATUS);
     }
-    strncat(buffer, "  房产:\n", sizeof(buffer) - strlen(buffer) - 1);
+    emit_event(ctx, EVT_QUERY_HOUSES);
     bool has_house = false;
-    for (int i = 0; i < MAP_SIZE; i++) {
-        if (g_game_state.houses[i].owner_id == p->index) {
-            snprintf(line, sizeof(line), "    - 位置 %d (等级 %d)\n", i, g_game_state.houses[i].level);
-            strncat(buffer, line, sizeof(buffer) - strlen(buffer) - 1);
-            has_house = true;
-        }
+    for (int loc = next_owned_house(ctx, p->index, -1); loc >= 0; loc = next_owned_house(ctx, p->index, loc)) {
+        emit_event2(ctx, EVT_QUERY_HOUSE, loc, ctx->state.houses[loc].level);
+        has_house = true;
     }
     if (!has_house) {
-        strncat(buffer, "    (无)\n", sizeof(buffer) - strlen(buffer) - 1);
+        emit_event(ctx, EVT_QUERY_NO_HOUSE);
     }
 
     // 显示地图财神状态
-    strncat(buffer, "  地图财神状态:\n", sizeof(buffer) - strlen(buffer) - 1);
-    if (g_game_state.god.location != -1) {
-        snprintf(line, sizeof(line), "    - 位置: %d (剩余 %d 回合消失)\n", g_game_state.god.location, g_game_state.god.duration);
-        strncat(buffer, line, sizeof(buffer) - strlen(buffer) - 1);
+    emit_event(ctx, EVT_QUERY_GOD_HEADER);
+    if (ctx->state.god.location != -1) {
+        emit_event2(ctx, EVT_QUERY_GOD_ON_MAP, ctx->state.god.location, ctx->state.god.duration);
     } else {
-        snprintf(line, sizeof(line), "    - (未出现，预计 %d 回合后出现)\n", g_game_state.god.spawn_cooldown);
-        strncat(buffer, line, sizeof(buffer) - strlen(buffer) - 1);
+        emit_event1(ctx, EVT_QUERY_GOD_ABSENT, ctx->state.god.spawn_cooldown);
     }
-    
-    // 将所有内容复制到全局消息缓冲区
-    strncpy(g_last_action_message, buffer, sizeof(g_last_action_message) - 1);
 }
 
-void handle_help_command() {
-    char help_text[] =
-        "命令帮助:\n"
-        "roll\n"
-        "  掷骰子命令，行走1～6步，步数由随机算法产生。\n"
-        "sell n\n"
-        "  出售房产，n为房产在地图上的绝对位置，出售价格为投资总成本的2倍。\n"
-        "block n\n"
-        "  放置路障，n为前后相对距离（±10步），玩家经过将被拦截。\n"
-        "robot\n"
-        "  清扫前方10步内的障碍（路障）。\n"
-        "query\n"
-        "  显示自家资产信息。\n"
-        "help\n"
-        "  查看命令帮助。\n"
-        "quit\n"
-        "  强制退出游戏。\n"
-        "step n\n"
-        "  遥控骰子，指定行走步数。\n";
-    strncpy(g_last_action_message, help_text, sizeof(g_last_action_message) - 1);
+void handle_help_command(GameContext* ctx) {
+    // 帮助信息覆盖之前的消息
+    event_log_clear(&ctx->events);
+    emit_event(ctx, EVT_HELP);
 }
 
-void handle_quit_command() {
-    g_game_state.game.ended = true;
-    strncpy(g_last_action_message, "游戏已退出。\n", sizeof(g_last_action_message) - 1);
-    printf("%s", g_last_action_message); // 确保退出前能看到消息
-    exit(0); // 强制退出程序
+void handle_quit_command(GameContext* ctx) {
+    ctx->state.game.ended = true;
+    event_log_clear(&ctx->events);
+    emit_event(ctx, EVT_QUIT);
+    ctx->quit_requested = true; // 由驱动循环显示消息后退出
 }
 
 
-int get_initial_fund(void) {
+int get_initial_fund(GameContext* ctx) {
     char input[20];
     int fund = 10000; // 默认资金
     
     while (true) {
-        printf("请设置玩家初始资金（范围：1000～50000，默认10000），直接回车使用默认资金: ");
+        output_printf("请设置玩家初始资金（范围：1000～50000，默认10000），直接回车使用默认资金: ");
         
-        if (fgets(input, sizeof(input), stdin) == NULL) {
+        if (read_prompt_input(ctx, PROMPT_INITIAL_FUND, input, sizeof(input)) == NULL) {
             break; // 输入结束，使用默认资金
         }
         
@@ -386,44 +289,44 @@ int get_initial_fund(void) {
             fund = temp_fund;
             break; // 输入有效，退出循环
         } else {
-            printf("无效的资金数额，请输入1000～50000之间的数字，或直接回车使用默认资金。\n");
+            output_printf("无效的资金数额，请输入1000～50000之间的数字，或直接回车使用默认资金。\n");
         }
     }
     
-    printf("初始资金设置为: %d\n", fund);
+    output_printf("初始资金设置为: %d\n", fund);
     return fund;
 }
 
-void show_welcome_and_select_character(int initial_fund) {
+void show_welcome_and_select_character(GameContext* ctx, int initial_fund) {
     init_characters();
     
-    while (g_game_state.player_count < 2 || g_game_state.player_count > 4) {
+    while (ctx->state.player_count < 2 || ctx->state.player_count > PRESET_CHARACTER_COUNT) {
         show_character_selection();
         
         char input[10];
-        printf("请选择2～4位不重复玩家，输入编号即可（1、钱夫人；2、阿土伯；3、孙小美；4、金贝贝）: ");
-        if (fgets(input, sizeof(input), stdin) == NULL) {
+        output_printf("请选择2～4位不重复玩家，输入编号即可（1、钱夫人；2、阿土伯；3、孙小美；4、金贝贝）: ");
+        if (read_prompt_input(ctx, PROMPT_CHARACTERS, input, sizeof(input)) == NULL) {
             return;
         }
         
         input[strcspn(input, "\n")] = 0;
         
         bool valid_input = true;
-        bool used[5] = {false};
+        bool used[PRESET_CHARACTER_COUNT + 1] = {false};
         int len = strlen(input);
-        if (len < 2 || len > 4) {
-            printf("请选择 2-4 位玩家。\n");
+        if (len < 2 || len > PRESET_CHARACTER_COUNT) {
+            output_printf("请选择 2-4 位玩家。\n");
             continue;
         }
         
         for (int i = 0; i < len; i++) {
-            if (input[i] < '1' || input[i] > '4') {
+            if (input[i] < '1' || input[i] > '0' + PRESET_CHARACTER_COUNT) {
                 valid_input = false;
                 break;
             }
             int digit = input[i] - '0';
             if (used[digit]) {
-                printf("角色选择重复。\n");
+                output_printf("角色选择重复。\n");
                 valid_input = false; 
                 break;
             }
@@ -431,154 +334,179 @@ void show_welcome_and_select_character(int initial_fund) {
         }
         
         if (!valid_input) {
-            printf("无效选择，请输入1-4之间的不重复数字。\n");
-            g_game_state.player_count = 0; // 重置玩家计数
+            output_printf("无效选择，请输入1-4之间的不重复数字。\n");
+            ctx->state.player_count = 0; // 重置玩家计数
             continue;
         }
         
         for (int i = 0; i < len; i++) {
             int choice = input[i] - '0';
-            Player* player = create_player_by_character(choice, initial_fund);
+            Player* player = create_player_by_character(ctx, choice, initial_fund);
             if (player) {
-                 printf("玩家 %s (%s) 加入游戏。\n", player->name, get_character_by_id(choice)->display_name);
+                 output_printf("玩家 %s (%s) 加入游戏。\n", player->name, get_character_by_id(choice)->display_name);
             }
         }
         
-        if (g_game_state.player_count > 0) {
-            printf("\n游戏开始！\n");
-            g_game_state.game.started = true;
+        if (ctx->state.player_count > 0) {
+            output_printf("\n游戏开始！\n");
+            ctx->state.game.started = true;
             break;
         }
     }
 }
 
-void run_game_with_preset(const char* preset_file) {
-    printf("大富翁游戏启动\n");
-    // 使用固定种子以确保测试结果一致
-    srand(12345); // 固定随机种子
-    
-    init_game_state();
-    bool game_started = false;
-    
-    const char* file_to_load = preset_file ? preset_file : "preset.json";
-    if (load_game_preset(file_to_load) == 0) {
-        printf("使用预设配置: %s\n", file_to_load);
-        game_started = true; // 使用预设配置时，游戏已经开始
-    } else {
-        int initial_fund = get_initial_fund();
-        show_welcome_and_select_character(initial_fund);
-        
-        if (g_game_state.player_count == 0) {
-            printf("没有选择任何角色，游戏结束\n");
-            return;
-        }
-        game_started = true;
-    }
-    
-    char command[100];
+void game_options_default(GameOptions* options) {
+    options->preset_file = NULL;
+    options->journal_file = NULL;
+    options->verbosity = VERBOSITY_FULL;
+    options->dump_style = JSON_STYLE_PRETTY;
+}
 
-    // 初始显示
-    printf(CLEAR_SCREEN);
-    display_map();
+void run_game_with_preset(const char* preset_file) {
+    GameOptions options;
+    game_options_default(&options);
+    options.preset_file = preset_file;
+    run_game_with_options(&options);
+}
 
+Player* advance_to_next_command(GameContext* ctx, const TurnHooks* hooks) {
     while (true) {
         // 财神状态更新应该移到合适的地方，而不是在每个游戏循环中都调用
 
         // 检查胜利条件
-        if (game_started && !g_game_state.game.ended) {
-            check_win_condition();
+        if (!ctx->state.game.ended) {
+            check_win_condition(ctx);
             
-            if (g_game_state.game.ended) {
-                char message_buffer[256];
-                if (g_game_state.game.winner_id != -1) {
-                    snprintf(message_buffer, sizeof(message_buffer), "游戏结束！胜利者是 %s！\n", g_game_state.players[g_game_state.game.winner_id].name);
+            if (ctx->state.game.ended) {
+                // 结束消息覆盖之前的消息；此处只显示不清空，随后的常规流程会再显示一次
+                event_log_clear(&ctx->events);
+                if (ctx->state.game.winner_id != -1) {
+                    emit_event1(ctx, EVT_GAME_WINNER, ctx->state.game.winner_id);
                 } else {
-                    snprintf(message_buffer, sizeof(message_buffer), "所有玩家都已破产，游戏结束！\n");
+                    emit_event(ctx, EVT_GAME_ALL_BANKRUPT);
                 }
-                strncpy(g_last_action_message, message_buffer, sizeof(g_last_action_message) - 1);
                 
-                printf(CLEAR_SCREEN);
-                display_map();
-                printf("%s", g_last_action_message);
+                hooks->show_game_over(ctx, hooks->user_data);
             }
         }
 
-        Player* current_player = &g_game_state.players[g_game_state.game.now_player_id];
+        Player* current_player = &ctx->state.players[ctx->state.game.now_player_id];
 
         // 检查财神附身状态（显示但不减少）
         if (current_player->buff.god > 0) {
-            char message_buffer[256];
-            snprintf(message_buffer, sizeof(message_buffer), "玩家 %s 有财神附身，免过路费，剩余 %d 回合。\n",
-                   current_player->name, current_player->buff.god);
-            strncat(g_last_action_message, message_buffer, sizeof(g_last_action_message) - strlen(g_last_action_message) - 1);
+            emit_event2(ctx, EVT_GOD_BUFF, player_slot(ctx, current_player), current_player->buff.god);
         }
 
         // 检查当前玩家是否已破产，如果是则自动跳过（游戏未结束时）
-        if (!current_player->alive && !g_game_state.game.ended) {
-            char message_buffer[256];
-            snprintf(message_buffer, sizeof(message_buffer), "玩家 %s 已破产，自动跳过。\n", current_player->name);
-            strncat(g_last_action_message, message_buffer, sizeof(g_last_action_message) - strlen(g_last_action_message) - 1);
-            switch_to_next_player(false); // 破产玩家跳过，不更新财神状态
+        if (!current_player->alive && !ctx->state.game.ended) {
+            emit_event1(ctx, EVT_PLAYER_SKIPPED, player_slot(ctx, current_player));
+            switch_to_next_player(ctx, false); // 破产玩家跳过，不更新财神状态
             continue; // 直接进入下一位玩家
         }
         
-        // 检查当前玩家是否在住院，如果是则自动跳过
-        // if (current_player->buff.hospital > 0) {
-        //     printf("玩家 %s 正在住院治疗，剩余 %d 天，本轮自动跳过。\n", 
-        //            current_player->name, current_player->buff.hospital);
-        //     current_player->buff.hospital--;
-        //     if (!g_game_state.game.ended) {
-        //         switch_to_next_player(true); // 玩家正确完成了移动，应该更新财神状态
-        //     }
-        //     //wait_for_enter();
-        //     continue; // 直接进入下一轮
-        // }
-        
-        // 检查当前玩家是否在监狱，如果是则自动跳过
-        // if (current_player->buff.prison > 0) {
-        //     printf("玩家 %s 正在监狱中，剩余 %d 天，本轮自动跳过。\n", 
-        //            current_player->name, current_player->buff.prison);
-        //     current_player->buff.prison--;
-        //     if (!g_game_state.game.ended) {
-        //         switch_to_next_player(true); // 玩家正确完成了移动，应该更新财神状态
-        //     }
-        //     //wait_for_enter();
-        //     continue; // 直接进入下一轮
-        // }
-        
-        
         // 如果有待处理的交互，现在执行它
-        if (g_game_state.game.interaction_pending) {
-            Player* player_for_interaction = &g_game_state.players[g_game_state.game.pending_interaction_player_id];
+        if (ctx->state.game.interaction_pending) {
+            Player* player_for_interaction = &ctx->state.players[ctx->state.game.pending_interaction_player_id];
             
-            // 先将移动消息打印出来
-            if (strlen(g_last_action_message) > 0) {
-                printf("%s", g_last_action_message);
-                g_last_action_message[0] = '\0'; // 打印后清空
-            }
+            // 先将移动消息打印出来，打印后清空
+            hooks->show_events(ctx, hooks->user_data);
 
             // 执行落地事件，这可能会产生新的交互或消息
-            on_player_land(player_for_interaction);
+            on_player_land(ctx, player_for_interaction);
 
             // 打印落地事件产生的消息（例如买地成功、获得点数等）
-            if (strlen(g_last_action_message) > 0) {
-                printf("%s", g_last_action_message);
-            }
+            hooks->show_events(ctx, hooks->user_data);
 
             // 完成后，清除所有状态
-            g_game_state.game.interaction_pending = false;
-            g_last_action_message[0] = '\0';
+            ctx->state.game.interaction_pending = false;
         } else {
-            // 如果没有交互，但有其他消息（如财神出现），在这里打印
-            if (strlen(g_last_action_message) > 0) {
-                printf("%s", g_last_action_message);
-                g_last_action_message[0] = '\0'; // 打印后清空
-            }
+            // 如果没有交互，但有其他消息（如财神出现），在这里打印并清空
+            hooks->show_events(ctx, hooks->user_data);
             
             // 如果没有交互，说明玩家回合已经完成
         }
 
-        printf("%s%c%s> ", current_player->color, current_player->name[0], COLOR_RESET);
+        return current_player;
+    }
+}
+
+static void terminal_show_events(GameContext* ctx, void* user_data) {
+    (void)user_data;
+    flush_events(ctx);
+}
+
+static void terminal_show_game_over(GameContext* ctx, void* user_data) {
+    renderer_draw((Renderer*)user_data, ctx);
+    print_events(ctx);
+}
+
+void run_game_with_options(const GameOptions* options) {
+    output_printf("大富翁游戏启动\n");
+    // 终端游戏使用独立的游戏上下文，固定种子以确保测试结果一致
+    GameContext context;
+    GameContext* ctx = &context;
+    game_context_init(ctx, 12345, 0);
+    ctx->events.verbosity = options->verbosity;
+    ctx->io.dump.style = options->dump_style;
+
+    Journal journal;
+    bool journaling = false;
+    if (options->journal_file) {
+        journaling = journal_open(&journal, options->journal_file, ctx->rng.seed, ctx->rng.stream,
+                                  ctx->board);
+        if (!journaling) {
+            output_printf("无法创建日志文件: %s\n", options->journal_file);
+        }
+    }
+    
+    const char* file_to_load = options->preset_file ? options->preset_file : "preset.json";
+    char* preset_text = read_text_file(file_to_load, NULL);
+    bool preset_loaded = false;
+    if (preset_text) {
+        JsonError error;
+        if (load_game_from_json(ctx, preset_text, &error) == 0) {
+            output_printf("使用预设配置: %s\n", file_to_load);
+            if (journaling) {
+                journal_record_preset(&journal, preset_text);
+            }
+            preset_loaded = true;
+        } else {
+            output_printf("预设文件格式错误: %s 第 %d 行第 %d 列: %s\n",
+                          file_to_load, error.line, error.column, error.message);
+        }
+        free(preset_text);
+    }
+    if (!preset_loaded) {
+        int initial_fund = get_initial_fund(ctx);
+        show_welcome_and_select_character(ctx, initial_fund);
+        
+        if (ctx->state.player_count == 0) {
+            output_printf("没有选择任何角色，游戏结束\n");
+            if (journaling) {
+                journal_close(&journal);
+            }
+            return;
+        }
+        if (journaling) {
+            journal_record_characters(&journal, ctx, initial_fund);
+        }
+    }
+    if (journaling) {
+        ctx->io.journal = &journal;
+    }
+    
+    char command[100];
+    Renderer renderer;
+    renderer_init(&renderer);
+    TurnHooks hooks = { terminal_show_events, terminal_show_game_over, &renderer };
+
+    // 初始显示
+    renderer_draw(&renderer, ctx);
+
+    while (true) {
+        Player* current_player = advance_to_next_command(ctx, &hooks);
+
+        output_printf("%s%c%s> ", current_player->color, current_player->name[0], COLOR_RESET);
         
         if (fgets(command, sizeof(command), stdin) == NULL) {
             break;
@@ -587,52 +515,59 @@ void run_game_with_preset(const char* preset_file) {
         // Trim trailing newline
         command[strcspn(command, "\n")] = 0;
         
-        process_command(command);
+        process_command(ctx, command);
+        if (ctx->quit_requested) {
+            flush_events(ctx); // 确保退出前能看到消息
+            break;
+        }
 
-        // 在处理命令后清屏并重绘
-        printf(CLEAR_SCREEN);
-        display_map();
+        // 在处理命令后重绘地图（终端下只更新变化的格子）
+        renderer_draw(&renderer, ctx);
 
         // 消息打印已在前面处理，这里不需要重复打印
     }
+
+    if (journaling) {
+        journal_close(&journal);
+    }
 }
 
-void switch_to_next_player(bool should_update_god) {
-    g_game_state.game.last_player_id = g_game_state.game.now_player_id;
+void switch_to_next_player(GameContext* ctx, bool should_update_god) {
+    ctx->state.game.last_player_id = ctx->state.game.now_player_id;
     
     // 找到下一个活跃的玩家
-    int next_player = (g_game_state.game.now_player_id + 1) % g_game_state.player_count;
-    while (!g_game_state.players[next_player].alive && next_player != g_game_state.game.now_player_id) {
-        next_player = (next_player + 1) % g_game_state.player_count;
+    int next_player = (ctx->state.game.now_player_id + 1) % ctx->state.player_count;
+    while (!ctx->state.players[next_player].alive && next_player != ctx->state.game.now_player_id) {
+        next_player = (next_player + 1) % ctx->state.player_count;
     }
-    g_game_state.game.now_player_id = next_player;
+    ctx->state.game.now_player_id = next_player;
     
     // 只在游戏未结束时更新next_player
-    if (!g_game_state.game.ended) {
+    if (!ctx->state.game.ended) {
         // 找到下一个活跃的玩家作为next_player
-        int next_next_player = (g_game_state.game.now_player_id + 1) % g_game_state.player_count;
-        while (!g_game_state.players[next_next_player].alive && next_next_player != g_game_state.game.now_player_id) {
-            next_next_player = (next_next_player + 1) % g_game_state.player_count;
+        int next_next_player = (ctx->state.game.now_player_id + 1) % ctx->state.player_count;
+        while (!ctx->state.players[next_next_player].alive && next_next_player != ctx->state.game.now_player_id) {
+            next_next_player = (next_next_player + 1) % ctx->state.player_count;
         }
-        g_game_state.game.next_player_id = next_next_player;
+        ctx->state.game.next_player_id = next_next_player;
     }
     
     // 当轮到第一个玩家时，表示新一轮开始，更新财神状态
     // 根据图片规则：回合是四个玩家都走完，所以财神状态应该在回合结束时更新
-    if (g_game_state.game.now_player_id == 0) {
+    if (ctx->state.game.now_player_id == 0) {
         // 在回合结束时，减少所有玩家的财神回合数
-        for (int i = 0; i < g_game_state.player_count; i++) {
-            if (g_game_state.players[i].buff.god > 0) {
-                g_game_state.players[i].buff.god--;
+        for (int i = 0; i < ctx->state.player_count; i++) {
+            if (ctx->state.players[i].buff.god > 0) {
+                ctx->state.players[i].buff.god--;
             }
         }
         
         // 在回合结束时，减少财神持续时间
-        if (g_game_state.god.location != -1) {
-            g_game_state.god.duration--;
+        if (ctx->state.god.location != -1) {
+            ctx->state.god.duration--;
         }
         
-        update_god_status();
+        update_god_status(ctx);
     }
 }
 
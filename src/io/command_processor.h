@@ -1,14 +1,41 @@
 #ifndef COMMAND_PROCESSOR_H
 #define COMMAND_PROCESSOR_H
 
-// 全局消息缓冲区
-extern char g_last_action_message[1024];
+#include <stdbool.h>
+#include "../game/game_context.h"
+
+// 终端游戏的启动选项
+typedef struct {
+    const char* preset_file;  // 预设文件，NULL 时尝试 preset.json
+    const char* journal_file; // 命令日志文件，NULL 时不记录
+    Verbosity verbosity;      // 消息详细程度
+    JsonStyle dump_style;     // dump 命令写出的存档格式
+} GameOptions;
 
 // 命令行处理函数声明
-void process_command(const char* command);
+void process_command(GameContext* ctx, const char* command);
+// 注册内置命令：注册表是进程内共享的只读表，须在程序启动时、处理任何命令和启动线程之前调用
+void register_builtin_commands(void);
+void game_options_default(GameOptions* options);
 void run_game(void);
 void run_game_with_preset(const char* preset_file);
-int get_initial_fund(void);
-void show_welcome_and_select_character(int initial_fund);
+void run_game_with_options(const GameOptions* options);
+int get_initial_fund(GameContext* ctx);
+void show_welcome_and_select_character(GameContext* ctx, int initial_fund);
+
+// 两条命令之间的显示钩子：终端负责显示，回放等无界面驱动只需丢弃消息
+typedef struct {
+    void (*show_events)(GameContext* ctx, void* user_data);    // 显示并清空当前消息
+    void (*show_game_over)(GameContext* ctx, void* user_data); // 游戏刚结束时显示结果
+    void* user_data;
+} TurnHooks;
+
+// 推进到等待下一条命令为止（胜负判定、跳过破产玩家、执行待处理的落地交互），
+// 返回需要输入命令的玩家
+Player* advance_to_next_command(GameContext* ctx, const TurnHooks* hooks);
+
+// 回合推进函数（供无头模拟直接驱动）
+void handle_roll_command(GameContext* ctx);
+void switch_to_next_player(GameContext* ctx, bool should_update_god);
 
 #endif // COMMAND_PROCESSOR_H
\ No newline at end of file
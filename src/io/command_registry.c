@@ -0,0 +1,165 @@
+#include "command_registry.h"
+#include <ctype.h>
+#include <stdlib.h>
+#include <string.h>
+
+static const CommandSpec* s_commands[COMMAND_REGISTRY_CAPACITY];
+static int s_command_count = 0;
+
+static bool is_blank(char c) {
+    return c == ' ' || c == '\t';
+}
+
+// 名称与一段文本按不区分大小写比较，名称较小返回负数
+static int compare_name(const char* name, const char* text, int len) {
+    for (int i = 0; i < len; i++) {
+        unsigned char n = (unsigned char)name[i];
+        unsigned char t = (unsigned char)tolower((unsigned char)text[i]);
+        if (n != t) {
+            return n < t ? -1 : 1; // 名称先结束时 n 为 0，同样较小
+        }
+    }
+    return name[len] == '\0' ? 0 : 1;
+}
+
+bool command_register(const CommandSpec* spec) {
+    int len = (int)strlen(spec->name);
+    int lo = 0, hi = s_command_count;
+    while (lo < hi) {
+        int mid = (lo + hi) / 2;
+        if (compare_name(s_commands[mid]->name, spec->name, len) < 0) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    if (lo < s_command_count && compare_name(s_commands[lo]->name, spec->name, len) == 0) {
+        s_commands[lo] = spec;
+        return true;
+    }
+    if (s_command_count == COMMAND_REGISTRY_CAPACITY) {
+        return false;
+    }
+    memmove(&s_commands[lo + 1], &s_commands[lo], (size_t)(s_command_count - lo) * sizeof(s_commands[0]));
+    s_commands[lo] = spec;
+    s_command_count++;
+    return true;
+}
+
+const CommandSpec* command_lookup(const char* name, int len) {
+    int lo = 0, hi = s_command_count - 1;
+    while (lo <= hi) {
+        int mid = (lo + hi) / 2;
+        int cmp = compare_name(s_commands[mid]->name, name, len);
+        if (cmp == 0) {
+            return s_commands[mid];
+        }
+        if (cmp < 0) {
+            lo = mid + 1;
+        } else {
+            hi = mid - 1;
+        }
+    }
+    return NULL;
+}
+
+// 旧写法：参数紧跟命令名，取最长的匹配
+static const CommandSpec* lookup_attached(const char* line, const char** rest) {
+    const CommandSpec* best = NULL;
+    int best_len = 0;
+    for (int i = 0; i < s_command_count; i++) {
+        const CommandSpec* spec = s_commands[i];
+        if (!spec->args_attached) {
+            continue;
+        }
+        int len = (int)strlen(spec->name);
+        if (len > best_len) {
+            int j = 0;
+            while (j < len && line[j] && tolower((unsigned char)line[j]) == spec->name[j]) {
+                j++;
+            }
+            if (j == len) {
+                best = spec;
+                best_len = len;
+            }
+        }
+    }
+    *rest = line + best_len;
+    return best;
+}
+
+static bool parse_args(const CommandSpec* spec, const char* rest, CommandArgs* args) {
+    args->count = 0;
+    const char* p = rest;
+    for (int i = 0; i < spec->arg_count; i++) {
+        while (is_blank(*p)) p++;
+        if (*p == '\0') {
+            return false;
+        }
+        const char* start = p;
+        while (*p && !is_blank(*p)) p++;
+
+        CommandArg* arg = &args->items[i];
+        arg->text = start;
+        arg->len = (int)(p - start);
+        arg->value = 0;
+        if (spec->arg_types[i] == COMMAND_ARG_INT) {
+            // 与 %d 一致：取开头的数字部分
+            char* end;
+            long value = strtol(start, &end, 10);
+            if (end == start) {
+                return false;
+            }
+            arg->value = (int)value;
+        }
+        args->count++;
+    }
+    return true;
+}
+
+CommandResult command_execute(GameContext* ctx, const char* line) {
+    // 命令名以空格结束；参数之间可以是空格或制表符
+    const char* word_end = line;
+    while (*word_end && *word_end != ' ') word_end++;
+
+    const char* rest = word_end;
+    const CommandSpec* spec = command_lookup(line, (int)(word_end - line));
+    if (!spec) {
+        spec = lookup_attached(line, &rest);
+        if (!spec) {
+            return COMMAND_NOT_FOUND;
+        }
+    }
+
+    CommandArgs args;
+    args.count = 0;
+    if (!spec->args_attached) {
+        if (*rest == '\0') {
+            // 只有命令名：无参命令或参数可省略的命令直接执行
+            if (spec->arg_count > 0 && !spec->args_optional) {
+                return COMMAND_NOT_FOUND;
+            }
+            spec->handler(ctx, &args);
+            return COMMAND_EXECUTED;
+        }
+        if (spec->arg_count == 0) {
+            return COMMAND_NOT_FOUND;
+        }
+    }
+
+    if (!parse_args(spec, rest, &args)) {
+        if (spec->error_replaces_messages) {
+            event_log_clear(&ctx->events);
+        }
+        emit_event(ctx, spec->format_error);
+        return COMMAND_BAD_ARGUMENTS;
+    }
+    spec->handler(ctx, &args);
+    return COMMAND_EXECUTED;
+}
+
+void command_arg_copy(const CommandArg* arg, char* buffer, int size) {
+    int len = arg->len < size - 1 ? arg->len : size - 1;
+    memcpy(buffer, arg->text, (size_t)len);
+    buffer[len] = '\0';
+}
@@ -0,0 +1,55 @@
+#ifndef COMMAND_REGISTRY_H
+#define COMMAND_REGISTRY_H
+
+#include <stdbool.h>
+#include "../game/game_context.h"
+
+// 命令注册表：按名称排序，二分查找
+// 命令行只扫描一遍，参数以指向原命令行的切片给出，不复制也不修改输入
+#define COMMAND_MAX_ARGS 4
+#define COMMAND_REGISTRY_CAPACITY 64
+
+typedef enum {
+    COMMAND_ARG_INT,   // 整数（与 %d 相同：可带正负号，读到非数字为止）
+    COMMAND_ARG_WORD   // 不含空白的一段文本
+} CommandArgType;
+
+typedef struct {
+    const char* text;  // 指向原命令行，不以 '\0' 结尾
+    int len;
+    int value;         // COMMAND_ARG_INT 的数值
+} CommandArg;
+
+typedef struct {
+    int count;
+    CommandArg items[COMMAND_MAX_ARGS];
+} CommandArgs;
+
+typedef void (*CommandHandler)(GameContext* ctx, const CommandArgs* args);
+
+typedef struct {
+    const char* name;              // 小写命令名，匹配时不区分大小写
+    int arg_count;                 // 参数个数，多余的参数忽略
+    CommandArgType arg_types[COMMAND_MAX_ARGS];
+    bool args_optional;            // 命令名后什么都没有时也可执行（如 dump）
+    bool args_attached;            // 兼容旧写法：参数可紧跟命令名（step5、loadfile.json）
+    EventId format_error;          // 参数不符时的提示
+    bool error_replaces_messages;  // 提示覆盖之前的消息
+    CommandHandler handler;
+} CommandSpec;
+
+typedef enum {
+    COMMAND_EXECUTED,      // 已执行
+    COMMAND_BAD_ARGUMENTS, // 命令存在但参数不符，已给出提示
+    COMMAND_NOT_FOUND      // 没有匹配的命令
+} CommandResult;
+
+// 注册命令（同名则替换），spec 须在整个程序运行期间有效；应在启动阶段调用
+bool command_register(const CommandSpec* spec);
+const CommandSpec* command_lookup(const char* name, int len);
+CommandResult command_execute(GameContext* ctx, const char* line);
+
+// 把参数复制为以 '\0' 结尾的字符串（截断到 size - 1），供需要 C 字符串的处理函数使用
+void command_arg_copy(const CommandArg* arg, char* buffer, int size);
+
+#endif // COMMAND_REGISTRY_H
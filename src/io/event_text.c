@@ -0,0 +1,99 @@
+#include "event_text.h"
+#include "output.h"
+#include "../game/message_catalog.h"
+#include <string.h>
+
+// 追加到定长缓冲区，超出部分截断
+typedef struct {
+    char* data;
+    size_t size;
+    size_t len;
+} TextSink;
+
+static void sink_append(TextSink* sink, const char* s, size_t n) {
+    if (sink->size == 0) return;
+    size_t room = sink->size - 1 - sink->len;
+    if (n > room) n = room;
+    memcpy(sink->data + sink->len, s, n);
+    sink->len += n;
+}
+
+static void sink_append_int(TextSink* sink, int32_t value) {
+    char digits[12];
+    int pos = (int)sizeof(digits);
+    uint32_t v = value < 0 ? (uint32_t)0 - (uint32_t)value : (uint32_t)value;
+    do {
+        digits[--pos] = (char)('0' + v % 10);
+        v /= 10;
+    } while (v > 0);
+    if (value < 0) digits[--pos] = '-';
+    sink_append(sink, digits + pos, sizeof(digits) - (size_t)pos);
+}
+
+static const char* player_name(const GameContext* ctx, int slot) {
+    if (slot < 0 || slot >= MAX_PLAYERS) return "";
+    return ctx->state.players[slot].name;
+}
+
+size_t format_event(const GameContext* ctx, const GameEvent* event, char* buffer, size_t size) {
+    TextSink sink = { buffer, size, 0 };
+    const char* t = message_template((EventId)event->id)->text;
+    int arg = 0;
+
+    while (*t) {
+        const char* mark = strchr(t, '%');
+        if (!mark) {
+            sink_append(&sink, t, strlen(t));
+            break;
+        }
+        sink_append(&sink, t, (size_t)(mark - t));
+        if (mark[1] == '\0') break;
+
+        int32_t value = arg < EVENT_MAX_ARGS ? event->args[arg] : 0;
+        switch (mark[1]) {
+            case 'd':
+                sink_append_int(&sink, value);
+                arg++;
+                break;
+            case 'p': {
+                const char* name = player_name(ctx, value);
+                sink_append(&sink, name, strlen(name));
+                arg++;
+                break;
+            }
+            case 's': {
+                const char* text = event_log_string(&ctx->events, event);
+                sink_append(&sink, text, strlen(text));
+                arg++;
+                break;
+            }
+            default:
+                sink_append(&sink, mark + 1, 1);
+                break;
+        }
+        t = mark + 2;
+    }
+
+    if (size > 0) buffer[sink.len] = '\0';
+    return sink.len;
+}
+
+void print_events(GameContext* ctx) {
+    char buffer[1024];
+    uint32_t count = event_log_count(&ctx->events);
+    // 缓冲区写满时最旧的消息已被覆盖，先说明省略了多少条
+    if (ctx->events.dropped > 0) {
+        GameEvent notice = { EVT_EVENTS_DROPPED, { (int32_t)ctx->events.dropped, 0, 0 } };
+        size_t len = format_event(ctx, &notice, buffer, sizeof(buffer));
+        output_write(buffer, len);
+    }
+    for (uint32_t i = 0; i < count; i++) {
+        size_t len = format_event(ctx, event_log_at(&ctx->events, i), buffer, sizeof(buffer));
+        output_write(buffer, len);
+    }
+}
+
+void flush_events(GameContext* ctx) {
+    print_events(ctx);
+    event_log_clear(&ctx->events);
+}
@@ -0,0 +1,16 @@
+#ifndef EVENT_TEXT_H
+#define EVENT_TEXT_H
+
+#include <stddef.h>
+#include "../game/game_context.h"
+
+// 将单个事件格式化为文本，返回写入的字节数（不含结尾的 '\0'）
+size_t format_event(const GameContext* ctx, const GameEvent* event, char* buffer, size_t size);
+
+// 显示所有待显示事件，保留在事件日志中
+void print_events(GameContext* ctx);
+
+// 显示所有待显示事件后清空事件日志
+void flush_events(GameContext* ctx);
+
+#endif // EVENT_TEXT_H
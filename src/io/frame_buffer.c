@@ -0,0 +1,40 @@
+#include "frame_buffer.h"
+#include "output.h"
+#include <stdarg.h>
+#include <stdio.h>
+#include <string.h>
+
+void frame_init(FrameBuffer* fb) {
+    fb->len = 0;
+}
+
+void frame_flush(FrameBuffer* fb) {
+    output_write_frame(fb->data, fb->len);
+    fb->len = 0;
+}
+
+void frame_append(FrameBuffer* fb, const char* s, size_t n) {
+    if (fb->len + n > sizeof(fb->data)) frame_flush(fb);
+    if (n > sizeof(fb->data)) n = sizeof(fb->data);
+    memcpy(fb->data + fb->len, s, n);
+    fb->len += n;
+}
+
+void frame_puts(FrameBuffer* fb, const char* s) {
+    frame_append(fb, s, strlen(s));
+}
+
+void frame_putc(FrameBuffer* fb, char c) {
+    frame_append(fb, &c, 1);
+}
+
+void frame_printf(FrameBuffer* fb, const char* format, ...) {
+    char buffer[256];
+    va_list args;
+    va_start(args, format);
+    int n = vsnprintf(buffer, sizeof(buffer), format, args);
+    va_end(args);
+    if (n < 0) return;
+    if ((size_t)n >= sizeof(buffer)) n = sizeof(buffer) - 1;
+    frame_append(fb, buffer, (size_t)n);
+}
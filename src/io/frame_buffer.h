@@ -0,0 +1,23 @@
+#ifndef FRAME_BUFFER_H
+#define FRAME_BUFFER_H
+
+#include <stddef.h>
+
+#define FRAME_BUFFER_SIZE 8192
+
+// 整帧输出缓冲区：一帧内容（含颜色、光标控制序列）拼好后交给输出后端一次写出
+typedef struct {
+    char data[FRAME_BUFFER_SIZE];
+    size_t len;
+} FrameBuffer;
+
+void frame_init(FrameBuffer* fb);
+void frame_append(FrameBuffer* fb, const char* s, size_t n);
+void frame_puts(FrameBuffer* fb, const char* s);
+void frame_putc(FrameBuffer* fb, char c);
+void frame_printf(FrameBuffer* fb, const char* format, ...);
+
+// 通过当前输出后端写出缓冲区内容（stdio 后端会先刷新 stdout 以保证顺序）
+void frame_flush(FrameBuffer* fb);
+
+#endif // FRAME_BUFFER_H
@@ -0,0 +1,372 @@
+#include "journal.h"
+#include "command_processor.h"
+#include "json_serializer.h"
+#include "output.h"
+#include "../game/character.h"
+#include "../game/player.h"
+#include <stdlib.h>
+#include <string.h>
+
+#define JOURNAL_HEADER_SIZE (28 + BOARD_LABEL_SIZE)
+#define JOURNAL_PROMPT_EOF 1
+
+// ---- 编码 ----
+
+static size_t put_varint(unsigned char* out, uint64_t value) {
+    size_t n = 0;
+    while (value >= 0x80) {
+        out[n++] = (unsigned char)(value | 0x80);
+        value >>= 7;
+    }
+    out[n++] = (unsigned char)value;
+    return n;
+}
+
+static void put_u32(unsigned char* out, uint32_t value) {
+    for (int i = 0; i < 4; i++) {
+        out[i] = (unsigned char)(value >> (8 * i));
+    }
+}
+
+static void put_u64(unsigned char* out, uint64_t value) {
+    for (int i = 0; i < 8; i++) {
+        out[i] = (unsigned char)(value >> (8 * i));
+    }
+}
+
+// 写入失败时提示一次并关闭文件，之后的记录全部忽略
+static void journal_fail(Journal* journal) {
+    output_printf("无法写入日志文件: %s，已停止记录\n", journal->filename);
+    fclose(journal->file);
+    journal->file = NULL;
+    journal->failed = true;
+}
+
+// 写一条记录：类型、负载长度、定长前缀和正文，写完立即刷新
+static void write_record(Journal* journal, JournalRecordType type,
+                         const unsigned char* prefix, size_t prefix_len,
+                         const char* text, size_t text_len) {
+    if (!journal->file) {
+        return;
+    }
+    unsigned char head[1 + 10];
+    head[0] = (unsigned char)type;
+    size_t head_len = 1 + put_varint(head + 1, prefix_len + text_len);
+
+    bool ok = fwrite(head, 1, head_len, journal->file) == head_len;
+    if (ok && prefix_len > 0) {
+        ok = fwrite(prefix, 1, prefix_len, journal->file) == prefix_len;
+    }
+    if (ok && text_len > 0) {
+        ok = fwrite(text, 1, text_len, journal->file) == text_len;
+    }
+    if (!ok || fflush(journal->file) != 0) {
+        journal_fail(journal);
+        return;
+    }
+    journal->records++;
+}
+
+bool journal_open(Journal* journal, const char* filename, uint64_t seed, uint64_t stream, const Board* board) {
+    journal->filename = filename;
+    journal->records = 0;
+    journal->failed = false;
+    journal->file = fopen(filename, "wb");
+    if (!journal->file) {
+        return false;
+    }
+
+    unsigned char header[JOURNAL_HEADER_SIZE] = { 0 };
+    memcpy(header, JOURNAL_MAGIC, 4);
+    put_u32(header + 4, JOURNAL_VERSION);
+    put_u64(header + 8, seed);
+    put_u64(header + 16, stream);
+    put_u32(header + 24, (uint32_t)board->size);
+    memcpy(header + 28, board->name, strlen(board->name)); // 名称长度小于 BOARD_LABEL_SIZE，末尾保留 0
+    if (fwrite(header, 1, sizeof(header), journal->file) != sizeof(header) || fflush(journal->file) != 0) {
+        fclose(journal->file);
+        journal->file = NULL;
+        return false;
+    }
+    return true;
+}
+
+void journal_close(Journal* journal) {
+    if (journal->file) {
+        if (fclose(journal->file) != 0 && !journal->failed) {
+            output_printf("无法写入日志文件: %s\n", journal->filename);
+        }
+        journal->file = NULL;
+    }
+}
+
+void journal_record_preset(Journal* journal, const char* json) {
+    write_record(journal, JOURNAL_PRESET, NULL, 0, json, strlen(json));
+}
+
+void journal_record_characters(Journal* journal, const GameContext* ctx, int initial_fund) {
+    unsigned char prefix[10 + MAX_PLAYERS];
+    size_t len = put_varint(prefix, (uint64_t)initial_fund);
+
+    // 角色编号按名字反查，顺序即选择顺序
+    for (int i = 0; i < ctx->state.player_count; i++) {
+        for (int id = 1; id <= MAX_PLAYERS; id++) {
+            Character* character = get_character_by_id(id);
+            if (character && strcmp(character->name, ctx->state.players[i].name) == 0) {
+                prefix[len++] = (unsigned char)id;
+                break;
+            }
+        }
+    }
+    write_record(journal, JOURNAL_CHARACTERS, prefix, len, NULL, 0);
+}
+
+void journal_record_command(Journal* journal, uint64_t rng_draws, const char* command) {
+    unsigned char prefix[10];
+    size_t len = put_varint(prefix, rng_draws);
+    write_record(journal, JOURNAL_COMMAND, prefix, len, command, strlen(command));
+}
+
+void journal_record_prompt(Journal* journal, PromptKind kind, const char* answer) {
+    unsigned char prefix[2];
+    prefix[0] = (unsigned char)kind;
+    prefix[1] = answer ? 0 : JOURNAL_PROMPT_EOF;
+    write_record(journal, JOURNAL_PROMPT, prefix, 2, answer, answer ? strlen(answer) : 0);
+}
+
+// ---- 解码与回放 ----
+
+typedef struct {
+    JournalRecordType type;
+    const unsigned char* data;
+    size_t len;
+} JournalRecord;
+
+typedef struct {
+    const unsigned char* pos;
+    const unsigned char* end;
+    ReplayStats* stats;
+} JournalReader;
+
+static bool get_varint(const unsigned char** pos, const unsigned char* end, uint64_t* value) {
+    uint64_t result = 0;
+    for (int shift = 0; shift < 64 && *pos < end; shift += 7) {
+        unsigned char byte = *(*pos)++;
+        result |= (uint64_t)(byte & 0x7F) << shift;
+        if (!(byte & 0x80)) {
+            *value = result;
+            return true;
+        }
+    }
+    return false;
+}
+
+static uint32_t get_u32(const unsigned char* in) {
+    uint32_t value = 0;
+    for (int i = 3; i >= 0; i--) {
+        value = (value << 8) | in[i];
+    }
+    return value;
+}
+
+static uint64_t get_u64(const unsigned char* in) {
+    uint64_t value = 0;
+    for (int i = 7; i >= 0; i--) {
+        value = (value << 8) | in[i];
+    }
+    return value;
+}
+
+// 查看下一条记录但不前进；末尾不完整时标记截断
+static bool reader_peek(JournalReader* reader, JournalRecord* record, const unsigned char** next) {
+    const unsigned char* pos = reader->pos;
+    if (pos >= reader->end) {
+        return false;
+    }
+    record->type = (JournalRecordType)*pos++;
+    uint64_t len;
+    if (!get_varint(&pos, reader->end, &len) || len > (uint64_t)(reader->end - pos)) {
+        reader->stats->truncated = true;
+        reader->pos = reader->end;
+        return false;
+    }
+    record->data = pos;
+    record->len = (size_t)len;
+    *next = pos + len;
+    return true;
+}
+
+static bool reader_next(JournalReader* reader, JournalRecord* record) {
+    const unsigned char* next;
+    if (!reader_peek(reader, record, &next)) {
+        return false;
+    }
+    reader->pos = next;
+    return true;
+}
+
+// 回放时的交互输入：按顺序取出日志中的应答
+static char* replay_prompt_answer(GameContext* ctx, PromptKind kind, char* buffer, int size) {
+    JournalReader* reader = (JournalReader*)ctx->io.user_data;
+    JournalRecord record;
+    const unsigned char* next;
+    if (!reader_peek(reader, &record, &next) || record.type != JOURNAL_PROMPT || record.len < 2) {
+        // 记录中没有对应的应答，视为输入结束
+        reader->stats->prompt_mismatches++;
+        return NULL;
+    }
+    reader->pos = next;
+    reader->stats->prompts++;
+    if (record.data[0] != (unsigned char)kind) {
+        reader->stats->prompt_mismatches++;
+    }
+    if (record.data[1] & JOURNAL_PROMPT_EOF) {
+        return NULL;
+    }
+
+    size_t len = record.len - 2;
+    if (len > (size_t)size - 1) {
+        len = (size_t)size - 1;
+    }
+    memcpy(buffer, record.data + 2, len);
+    buffer[len] = '\0';
+    return buffer;
+}
+
+static void replay_discard_events(GameContext* ctx, void* user_data) {
+    (void)user_data;
+    event_log_clear(&ctx->events);
+}
+
+static void replay_ignore_game_over(GameContext* ctx, void* user_data) {
+    (void)ctx;
+    (void)user_data;
+}
+
+// 按开局记录建立初始状态
+static bool replay_setup(GameContext* ctx, const JournalRecord* record) {
+    if (record->type == JOURNAL_PRESET) {
+        char* json = (char*)malloc(record->len + 1);
+        if (!json) {
+            return false;
+        }
+        memcpy(json, record->data, record->len);
+        json[record->len] = '\0';
+        int result = load_game_from_json(ctx, json, NULL);
+        free(json);
+        return result == 0;
+    }
+    if (record->type == JOURNAL_CHARACTERS) {
+        const unsigned char* pos = record->data;
+        const unsigned char* end = record->data + record->len;
+        uint64_t fund;
+        if (!get_varint(&pos, end, &fund)) {
+            return false;
+        }
+        init_characters();
+        while (pos < end) {
+            create_player_by_character(ctx, *pos++, (int)fund);
+        }
+        ctx->state.game.started = ctx->state.player_count > 0;
+        return true;
+    }
+    return false;
+}
+
+static unsigned char* read_binary_file(const char* filename, size_t* size) {
+    FILE* file = fopen(filename, "rb");
+    if (!file) {
+        return NULL;
+    }
+    fseek(file, 0, SEEK_END);
+    long length = ftell(file);
+    fseek(file, 0, SEEK_SET);
+    unsigned char* data = length > 0 ? (unsigned char*)malloc((size_t)length) : NULL;
+    if (data) {
+        *size = fread(data, 1, (size_t)length, file);
+    }
+    fclose(file);
+    return data;
+}
+
+ReplayResult replay_journal(GameContext* ctx, const char* filename, ReplayStats* stats) {
+    memset(stats, 0, sizeof(*stats));
+
+    size_t size = 0;
+    unsigned char* data = read_binary_file(filename, &size);
+    if (!data) {
+        return REPLAY_FILE_ERROR;
+    }
+    if (size < JOURNAL_HEADER_SIZE || memcmp(data, JOURNAL_MAGIC, 4) != 0 || get_u32(data + 4) != JOURNAL_VERSION) {
+        free(data);
+        return REPLAY_FILE_ERROR;
+    }
+
+    game_context_init(ctx, get_u64(data + 8), get_u64(data + 16));
+    ctx->events.verbosity = VERBOSITY_QUIET;
+
+    // 地图不同时命令的结果全都对不上，直接拒绝
+    stats->board_size = (int)get_u32(data + 24);
+    memcpy(stats->board_name, data + 28, BOARD_LABEL_SIZE - 1);
+    if (stats->board_size != ctx->board->size || strcmp(stats->board_name, ctx->board->name) != 0) {
+        free(data);
+        return REPLAY_BOARD_MISMATCH;
+    }
+
+    JournalReader reader = { data + JOURNAL_HEADER_SIZE, data + size, stats };
+    JournalRecord record;
+    if (!reader_next(&reader, &record) || !replay_setup(ctx, &record)) {
+        free(data);
+        return REPLAY_FILE_ERROR;
+    }
+
+    ctx->io.read_prompt = replay_prompt_answer;
+    ctx->io.echo_prompts = false;
+    ctx->io.user_data = &reader;
+    TurnHooks hooks = { replay_discard_events, replay_ignore_game_over, NULL };
+
+    advance_to_next_command(ctx, &hooks);
+    while (reader_next(&reader, &record)) {
+        if (record.type != JOURNAL_COMMAND) {
+            // 多余的交互应答：回放已与记录不一致
+            if (record.type == JOURNAL_PROMPT) {
+                stats->prompt_mismatches++;
+            }
+            continue;
+        }
+
+        const unsigned char* pos = record.data;
+        const unsigned char* end = record.data + record.len;
+        uint64_t draws;
+        if (!get_varint(&pos, end, &draws)) {
+            stats->truncated = true;
+            break;
+        }
+        if (draws != ctx->rng.draws) {
+            stats->rng_mismatches++;
+        }
+
+        // 与终端输入缓冲一致，命令最长 99 字节
+        char command[100];
+        size_t len = (size_t)(end - pos);
+        if (len > sizeof(command) - 1) {
+            len = sizeof(command) - 1;
+        }
+        memcpy(command, pos, len);
+        command[len] = '\0';
+
+        process_command(ctx, command);
+        stats->commands++;
+        if (ctx->quit_requested) {
+            break;
+        }
+        advance_to_next_command(ctx, &hooks);
+    }
+
+    event_log_clear(&ctx->events);
+    ctx->io.read_prompt = NULL;
+    ctx->io.echo_prompts = true;
+    ctx->io.user_data = NULL;
+    free(data);
+    return REPLAY_OK;
+}
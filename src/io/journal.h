@@ -0,0 +1,65 @@
+#ifndef JOURNAL_H
+#define JOURNAL_H
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include "../game/game_context.h"
+
+// 二进制命令日志（只追加）
+//
+// 文件头：魔数 "RJNL"、u32 版本、u64 种子、u64 流号、u32 地图格子数、地图名称（定长，以 0 填充；整数均为小端）
+// 之后是连续的记录：u8 类型 + varint 负载长度 + 负载
+//   JOURNAL_PRESET      开局使用的预设 JSON 原文
+//   JOURNAL_CHARACTERS  varint 初始资金 + 每位玩家的角色编号（各 1 字节）
+//   JOURNAL_COMMAND     varint 执行前的随机数抽取次数 + 命令原文
+//   JOURNAL_PROMPT      u8 交互类型 + u8 标志（1 表示输入结束）+ 应答原文
+// 每条记录写完即刷新，程序异常退出时最多丢失最后一条不完整的记录
+// 写入失败（如磁盘已满）时提示一次并停止记录，已写入的部分仍可回放
+#define JOURNAL_MAGIC "RJNL"
+#define JOURNAL_VERSION 2
+
+typedef enum {
+    JOURNAL_PRESET = 1,
+    JOURNAL_CHARACTERS = 2,
+    JOURNAL_COMMAND = 3,
+    JOURNAL_PROMPT = 4
+} JournalRecordType;
+
+typedef struct Journal {
+    FILE* file;
+    const char* filename;
+    uint64_t records;  // 已写入的记录数
+    bool failed;       // 发生过写入错误，此后不再记录
+} Journal;
+
+typedef enum {
+    REPLAY_OK = 0,
+    REPLAY_FILE_ERROR,     // 文件无法读取或格式不符
+    REPLAY_BOARD_MISMATCH  // 日志记录的地图与当前地图不同
+} ReplayResult;
+
+// 回放统计
+typedef struct {
+    uint64_t commands;          // 回放的命令数
+    uint64_t prompts;           // 消耗的交互应答数
+    uint64_t rng_mismatches;    // 命令执行前随机数位置与记录不一致的次数
+    uint64_t prompt_mismatches; // 交互应答与记录对不上的次数
+    bool truncated;             // 日志末尾有不完整的记录
+    char board_name[BOARD_LABEL_SIZE]; // 日志记录的地图名称
+    int board_size;             // 日志记录的地图格子数
+} ReplayStats;
+
+// 记录；filename 须在记录期间保持有效
+bool journal_open(Journal* journal, const char* filename, uint64_t seed, uint64_t stream, const Board* board);
+void journal_close(Journal* journal);
+void journal_record_preset(Journal* journal, const char* json);
+void journal_record_characters(Journal* journal, const GameContext* ctx, int initial_fund);
+void journal_record_command(Journal* journal, uint64_t rng_draws, const char* command);
+void journal_record_prompt(Journal* journal, PromptKind kind, const char* answer);
+
+// 回放：不经过终端循环，直接在 ctx 上重建日志结束时的游戏状态
+// 须先选定与记录时相同的地图，否则返回 REPLAY_BOARD_MISMATCH 且不回放
+ReplayResult replay_journal(GameContext* ctx, const char* filename, ReplayStats* stats);
+
+#endif // JOURNAL_H
@@ -1,572 +1,358 @@
+#define _POSIX_C_SOURCE 200809L
+
 #include "json_serializer.h"
 #include "../game/game_state.h"
 #include "../game/player.h"
+#include "../game/tile_set.h"
+#include "../game/ownership.h"
+#include "../game/occupancy.h"
 #include "colors.h"
+#include "../utils/json_reader.h"
 #include <stdio.h>
 #include <string.h>
 #include <stdlib.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+
+// 存档的常见大小远小于此，放不下时才按实际长度分配
+#define DUMP_STACK_BUFFER_SIZE 16384
 
-void save_game_dump(const char *filename)
+// ---- 保存：整份存档写进一块缓冲区，再一次性写入文件 ----
+
+static void write_position_list(JsonWriter *w, const char *key, const TileSet *tiles, int map_size)
 {
-    FILE *file = fopen(filename, "w");
-    if (!file)
-    {
-        printf("错误: 无法创建文件 %s\n", filename);
-        return;
-    }
+    json_writer_begin_array(w, key, true);
+    for (int i = tile_set_first_in(tiles, 0, map_size - 1); i >= 0; i = tile_set_first_in(tiles, i + 1, map_size - 1))
+        json_writer_int(w, NULL, i);
+    json_writer_end_array(w);
+}
 
-    fprintf(file, "{\n");
-    fprintf(file, "    \"players\": [\n");
+size_t save_game_to_buffer(const GameContext* ctx, char *buffer, size_t size, JsonStyle style)
+{
+    JsonWriter w;
+    json_writer_init(&w, buffer, size, style);
+    json_writer_begin_object(&w, NULL);
 
-    bool first_player = true;
-    for (int i = 0; i < g_game_state.player_count; i++)
+    json_writer_begin_array(&w, "players", false);
+    for (int i = 0; i < ctx->state.player_count; i++)
     {
-        Player *p = &g_game_state.players[i];
+        const Player *p = &ctx->state.players[i];
         if (p->index < 0)
             continue;
 
-        if (!first_player)
-        {
-            fprintf(file, ",\n");
-        }
-
-        fprintf(file, "        {\n");
-        fprintf(file, "            \"index\": %d,\n", p->index);
-        fprintf(file, "            \"name\": \"%s\",\n", p->name);
-        fprintf(file, "            \"fund\": %d,\n", p->fund);
-        fprintf(file, "            \"credit\": %d,\n", p->credit);
-        fprintf(file, "            \"location\": %d,\n", p->location);
-        fprintf(file, "            \"alive\": %s,\n", p->alive ? "true" : "false");
-        fprintf(file, "            \"prop\": {\n");
-        fprintf(file, "                \"bomb\": %d,\n", p->prop.bomb);
-        fprintf(file, "                \"barrier\": %d,\n", p->prop.barrier);
-        fprintf(file, "                \"robot\": %d,\n", p->prop.robot);
-        fprintf(file, "                \"total\": %d\n", p->prop.total);
-        fprintf(file, "            },\n");
-        fprintf(file, "            \"buff\": {\n");
-        fprintf(file, "                \"god\": %d,\n", p->buff.god);
-        fprintf(file, "                \"prison\": %d,\n", p->buff.prison);
-        fprintf(file, "                \"hospital\": %d\n", p->buff.hospital);
-        fprintf(file, "            }\n");
-        fprintf(file, "        }");
-        first_player = false;
+        json_writer_begin_object(&w, NULL);
+        json_writer_int(&w, "index", p->index);
+        json_writer_string(&w, "name", p->name);
+        json_writer_int(&w, "fund", p->fund);
+        json_writer_int(&w, "credit", p->credit);
+        json_writer_int(&w, "location", p->location);
+        json_writer_bool(&w, "alive", p->alive);
+        json_writer_begin_object(&w, "prop");
+        json_writer_int(&w, "bomb", p->prop.bomb);
+        json_writer_int(&w, "barrier", p->prop.barrier);
+        json_writer_int(&w, "robot", p->prop.robot);
+        json_writer_int(&w, "total", p->prop.total);
+        json_writer_end_object(&w);
+        json_writer_begin_object(&w, "buff");
+        json_writer_int(&w, "god", p->buff.god);
+        json_writer_int(&w, "prison", p->buff.prison);
+        json_writer_int(&w, "hospital", p->buff.hospital);
+        json_writer_end_object(&w);
+        json_writer_end_object(&w);
     }
-    fprintf(file, "\n    ],\n");
-    fprintf(file, "    \"houses\": {\n");
-    bool first_house = true;
-    for (int i = 0; i < MAP_SIZE; i++)
-    {
-        if (g_game_state.houses[i].owner_id != -1)
-        {
-            if (!first_house)
-            {
-                fprintf(file, ",\n");
-            }
-            fprintf(file, "        \"%d\": {\n", i);
+    json_writer_end_array(&w);
 
-            // 输出玩家名称而不是ID
-            int owner_id = g_game_state.houses[i].owner_id;
-            if (owner_id >= 0 && owner_id < g_game_state.player_count)
-            {
-                fprintf(file, "            \"owner\": \"%s\",\n", g_game_state.players[owner_id].name);
-            }
-            else
-            {
-                fprintf(file, "            \"owner\": %d,\n", owner_id);
-            }
-
-            fprintf(file, "            \"level\": %d\n", g_game_state.houses[i].level);
-            fprintf(file, "        }");
-            first_house = false;
-        }
-    }
-    fprintf(file, "\n    },\n");
-
-    fprintf(file, "    \"god\": {\n");
-    fprintf(file, "        \"spawn_cooldown\": %d,\n", g_game_state.god.spawn_cooldown);
-    fprintf(file, "        \"location\": %d,\n", g_game_state.god.location);
-    fprintf(file, "        \"duration\": %d\n", g_game_state.god.duration);
-    fprintf(file, "    },\n");
-
-    fprintf(file, "    \"placed_prop\": {\n");
-    fprintf(file, "        \"bomb\": [");
-    bool first_bomb = true;
-    for (int i = 0; i < MAP_SIZE; i++)
+    json_writer_begin_object(&w, "houses");
+    for (int i = 0; i < ctx->board->size; i++)
     {
-        if (g_game_state.placed_prop.bomb[i])
-        {
-            if (!first_bomb)
-            {
-                fprintf(file, ", ");
-            }
-            fprintf(file, "%d", i);
-            first_bomb = false;
-        }
-    }
-    fprintf(file, "],\n");
-    fprintf(file, "        \"barrier\": [");
-    bool first_barrier = true;
-    for (int i = 0; i < MAP_SIZE; i++)
-    {
-        if (g_game_state.placed_prop.barrier[i])
-        {
-            if (!first_barrier)
-            {
-                fprintf(file, ", ");
-            }
-            fprintf(file, "%d", i);
-            first_barrier = false;
-        }
-    }
-    fprintf(file, "]\n");
-    fprintf(file, "    },\n");
-
-    fprintf(file, "    \"game\": {\n");
-    fprintf(file, "        \"now_player\": %d,\n", g_game_state.game.now_player_id);
-    fprintf(file, "        \"next_player\": %d,\n", g_game_state.game.next_player_id);
-    // fprintf(file, "        \"started\": %s,\n", g_game_state.game.started ? "true" : "false");
-    fprintf(file, "        \"ended\": %s,\n", g_game_state.game.ended ? "true" : "false");
-    fprintf(file, "        \"winner\": %d\n", g_game_state.game.winner_id);
-    fprintf(file, "    }\n");
-    fprintf(file, "}\n");
+        const House *house = &ctx->state.houses[i];
+        if (house->owner_id == -1)
+            continue;
 
-    fclose(file);
+        char key[12];
+        snprintf(key, sizeof(key), "%d", i);
+        json_writer_begin_object(&w, key);
+        // 输出玩家名称而不是ID
+        if (house->owner_id >= 0 && house->owner_id < ctx->state.player_count)
+            json_writer_string(&w, "owner", ctx->state.players[house->owner_id].name);
+        else
+            json_writer_int(&w, "owner", house->owner_id);
+        json_writer_int(&w, "level", house->level);
+        json_writer_end_object(&w);
+    }
+    json_writer_end_object(&w);
+
+    json_writer_begin_object(&w, "god");
+    json_writer_int(&w, "spawn_cooldown", ctx->state.god.spawn_cooldown);
+    json_writer_int(&w, "location", ctx->state.god.location);
+    json_writer_int(&w, "duration", ctx->state.god.duration);
+    json_writer_end_object(&w);
+
+    json_writer_begin_object(&w, "placed_prop");
+    write_position_list(&w, "bomb", &ctx->state.placed_prop.bomb, ctx->board->size);
+    write_position_list(&w, "barrier", &ctx->state.placed_prop.barrier, ctx->board->size);
+    json_writer_end_object(&w);
+
+    json_writer_begin_object(&w, "game");
+    json_writer_int(&w, "now_player", ctx->state.game.now_player_id);
+    json_writer_int(&w, "next_player", ctx->state.game.next_player_id);
+    json_writer_bool(&w, "ended", ctx->state.game.ended);
+    json_writer_int(&w, "winner", ctx->state.game.winner_id);
+    json_writer_end_object(&w);
+
+    // 随机数发生器的种子和位置，加载后可确定性地续局
+    json_writer_begin_object(&w, "rng");
+    json_writer_uint(&w, "seed", ctx->rng.seed);
+    json_writer_uint(&w, "stream", ctx->rng.stream);
+    json_writer_uint(&w, "draws", ctx->rng.draws);
+    json_writer_end_object(&w);
+
+    json_writer_end_object(&w);
+    return json_writer_finish(&w);
 }
 
-// 辅助函数：从JSON字符串中提取字符串值
-char *extract_string_value(const char *json, const char *key, const char *end_pos)
+// 让目录项的修改（改名）落盘。调用时新文件已经就位，这一步只是尽力而为：
+// 目录无法打开（如没有读权限）或文件系统不支持对目录 fsync 时直接跳过，不算写入失败
+static void sync_parent_directory(const char *filename)
 {
-    char search_key[100];
-    sprintf(search_key, "\"%s\":", key);
-
-    char *key_pos = strstr(json, search_key);
-    if (!key_pos || (end_pos && key_pos > end_pos))
-    {
-        return NULL;
-    }
-
-    char *value_start = key_pos + strlen(search_key);
-    // 跳过可能的空白字符（空格、制表符等）
-    while (*value_start == ' ' || *value_start == '\t') {
-        value_start++;
-    }
-    
-    // 跳过开头的引号
-    if (*value_start == '"') {
-        value_start++;
-    } else {
-        return NULL;
-    }
-    
-    char *value_end = strchr(value_start, '"');
-    if (!value_end)
-    {
-        return NULL;
-    }
+    char dir[1024];
+    const char *slash = strrchr(filename, '/');
+    if (!slash)
+        snprintf(dir, sizeof(dir), ".");
+    else if (slash == filename)
+        snprintf(dir, sizeof(dir), "/");
+    else if (snprintf(dir, sizeof(dir), "%.*s", (int)(slash - filename), filename) >= (int)sizeof(dir))
+        return;
 
-    int len = value_end - value_start;
-    char *value = (char *)malloc(len + 1);
-    if (!value)
-        return NULL;
-    strncpy(value, value_start, len);
-    value[len] = '\0';
-    return value;
+    int fd = open(dir, O_RDONLY);
+    if (fd < 0)
+        return;
+    fsync(fd);
+    close(fd);
 }
 
-// 辅助函数：从JSON字符串中提取整数值
-int extract_int_value(const char *json, const char *key, const char *end_pos)
+int write_file_atomic(const char *filename, const void *data, size_t size)
 {
-    char search_key[100];
-    sprintf(search_key, "\"%s\":", key);
+    // 先写同目录下的临时文件，落盘后再改名覆盖，中途崩溃不会留下半个文件；
+    // 临时文件名由 mkstemp 生成，同时写同一目标的多个写入者互不干扰
+    char temp_name[1024];
+    if (snprintf(temp_name, sizeof(temp_name), "%s.XXXXXX", filename) >= (int)sizeof(temp_name))
+        return -1;
 
-    char *key_pos = strstr(json, search_key);
-    if (!key_pos || (end_pos && key_pos > end_pos))
+    int fd = mkstemp(temp_name);
+    if (fd < 0)
+        return -1;
+    // mkstemp 创建的文件只有属主可读写，改为普通文件的权限
+    fchmod(fd, S_IRUSR | S_IWUSR | S_IRGRP | S_IROTH);
+    FILE *file = fdopen(fd, "wb");
+    if (!file)
     {
-        return -1; // Or some other error indicator
+        close(fd);
+        remove(temp_name);
+        return -1;
     }
 
-    char *value_start = key_pos + strlen(search_key);
-    // 跳过可能的空白字符（空格、制表符等）
-    while (*value_start == ' ' || *value_start == '\t') {
-        value_start++;
+    bool ok = fwrite(data, 1, size, file) == size;
+    ok = fflush(file) == 0 && ok;
+    ok = fsync(fileno(file)) == 0 && ok;
+    ok = fclose(file) == 0 && ok;
+    if (!ok || rename(temp_name, filename) != 0)
+    {
+        remove(temp_name);
+        return -1;
     }
-    
-    return atoi(value_start);
+    sync_parent_directory(filename);
+    return 0;
 }
 
-// 辅助函数：提取布尔值
-bool extract_bool_value(const char *json, const char *key, const char *end_pos)
+int save_game_dump_with_style(const GameContext* ctx, const char *filename, JsonStyle style)
 {
-    char search_key[100];
-    sprintf(search_key, "\"%s\":", key);
-
-    char *key_pos = strstr(json, search_key);
-    if (!key_pos || (end_pos && key_pos > end_pos))
+    char stack_buffer[DUMP_STACK_BUFFER_SIZE];
+    char *data = stack_buffer;
+    size_t len = save_game_to_buffer(ctx, data, sizeof(stack_buffer), style);
+    if (len >= sizeof(stack_buffer))
     {
-        return false;
-    }
-
-    char *value_start = key_pos + strlen(search_key);
-    // 跳过可能的空白字符（空格、制表符等）
-    while (*value_start == ' ' || *value_start == '\t') {
-        value_start++;
+        data = (char *)malloc(len + 1);
+        if (data)
+            save_game_to_buffer(ctx, data, len + 1, style);
     }
-    
-    return strncmp(value_start, "true", 4) == 0;
-}
 
-// 辅助函数：找到匹配的大括号
-char *find_matching_brace(const char *start)
-{
-    if (!start || *start != '{')
-        return NULL;
-    int brace_level = 0;
-    const char *p = start;
-    do
-    {
-        if (*p == '{')
-        {
-            brace_level++;
-        }
-        else if (*p == '}')
-        {
-            brace_level--;
-        }
-        p++;
-    } while (brace_level > 0 && *p != '\0');
+    int result = data ? write_file_atomic(filename, data, len) : -1;
+    if (data != stack_buffer)
+        free(data);
 
-    return (brace_level == 0) ? (char *)p - 1 : NULL;
+    if (result != 0)
+        output_printf("错误: 无法创建文件 %s\n", filename);
+    return result;
 }
 
-// 辅助函数：解析player的prop对象
-void parse_player_prop(const char *player_obj, const char *player_end, Prop *prop)
+int save_game_dump(const GameContext* ctx, const char *filename)
 {
-    char *prop_start = strstr(player_obj, "\"prop\":");
-    if (!prop_start || prop_start > player_end)
-        return;
-
-    char *prop_obj_start = strchr(prop_start, '{');
-    if (!prop_obj_start)
-        return;
+    return save_game_dump_with_style(ctx, filename, JSON_STYLE_PRETTY);
+}
 
-    char *prop_obj_end = find_matching_brace(prop_obj_start);
-    if (!prop_obj_end || prop_obj_end > player_end)
-        return;
+// ---- 加载：整个文件单遍解析为 DOM，再按字段写入 GameState ----
 
-    prop->bomb = extract_int_value(prop_obj_start, "bomb", prop_obj_end);
-    prop->barrier = extract_int_value(prop_obj_start, "barrier", prop_obj_end);
-    prop->robot = extract_int_value(prop_obj_start, "robot", prop_obj_end);
-    prop->total = extract_int_value(prop_obj_start, "total", prop_obj_end);
+// 数字取整数部分，非数字的值按 0 处理
+static int node_int(const JsonNode *node)
+{
+    return node->type == JSON_NUMBER ? atoi(node->text) : 0;
 }
 
-// 辅助函数：解析player的buff对象
-void parse_player_buff(const char *player_obj, const char *player_end, Buff *buff)
+// 对象中的整数字段，缺省为 -1
+static int member_int(const JsonDocument *doc, const JsonNode *object, const char *key)
 {
-    char *buff_start = strstr(player_obj, "\"buff\":");
-    if (!buff_start || buff_start > player_end)
-        return;
-
-    char *buff_obj_start = strchr(buff_start, '{');
-    if (!buff_obj_start)
-        return;
-
-    char *buff_obj_end = find_matching_brace(buff_obj_start);
-    if (!buff_obj_end || buff_obj_end > player_end)
-        return;
-
-    buff->god = extract_int_value(buff_obj_start, "god", buff_obj_end);
-    buff->prison = extract_int_value(buff_obj_start, "prison", buff_obj_end);
-    buff->hospital = extract_int_value(buff_obj_start, "hospital", buff_obj_end);
+    const JsonNode *node = json_member(doc, object, key);
+    return node ? node_int(node) : -1;
 }
 
-// 解析god对象
-void parse_and_load_god(const char *content)
+// 对象中的布尔字段，只有 true 为真
+static bool member_bool(const JsonDocument *doc, const JsonNode *object, const char *key)
 {
-    // 查找顶级的 god 对象，而不是 buff 中的 god 字段
-    // 我们需要查找 "god": { 的模式，而不仅仅是 "god":
-    const char *search_pos = content;
-    const char *god_start = NULL;
-
-    // 循环查找所有的 "god": 直到找到后面跟着 { 的那个
-    while ((search_pos = strstr(search_pos, "\"god\":")) != NULL)
-    {
-        const char *check_pos = search_pos + strlen("\"god\":");
-        // 跳过空白字符
-        while (*check_pos == ' ' || *check_pos == '\t' || *check_pos == '\n' || *check_pos == '\r')
-        {
-            check_pos++;
-        }
-        // 检查是否是对象开始
-        if (*check_pos == '{')
-        {
-            god_start = search_pos;
-            break;
-        }
-        search_pos++; // 继续查找下一个
-    }
-
-    if (!god_start)
-    {
-        return;
-    }
-
-    char *obj_start = strchr(god_start, '{');
-    if (!obj_start)
-    {
-        return;
-    }
-
-    char *obj_end = find_matching_brace(obj_start);
-    if (!obj_end)
-    {
-        return;
-    }
+    const JsonNode *node = json_member(doc, object, key);
+    return node && node->type == JSON_BOOL && node->text[0] == 't';
+}
 
-    g_game_state.god.spawn_cooldown = extract_int_value(obj_start, "spawn_cooldown", obj_end);
-    g_game_state.god.location = extract_int_value(obj_start, "location", obj_end);
-    g_game_state.god.duration = extract_int_value(obj_start, "duration", obj_end);
+static const JsonNode *member_of_type(const JsonDocument *doc, const JsonNode *object, const char *key, JsonType type)
+{
+    const JsonNode *node = json_member(doc, object, key);
+    return (node && node->type == type) ? node : NULL;
 }
 
 // 解析players数组
-void parse_and_load_players(const char *content)
+static void load_players(GameContext* ctx, const JsonDocument *doc, const JsonNode *players)
 {
-    char *players_start = strstr(content, "\"players\":");
-    if (!players_start)
-        return;
-
-    char *arr_start = strchr(players_start, '[');
-    if (!arr_start)
-        return;
-
-    char *arr_end = strchr(arr_start, ']'); // Simple assumption
-    if (!arr_end)
-        return;
-
-    char *current = arr_start + 1;
     int i = 0;
-    while (current < arr_end && i < MAX_PLAYERS)
+    for (const JsonNode *item = json_first(doc, players); item && i < MAX_PLAYERS; item = json_next(doc, item))
     {
-        char *player_start = strchr(current, '{');
-        if (!player_start || player_start >= arr_end)
-            break;
-
-        char *player_end = find_matching_brace(player_start);
-        if (!player_end || player_end >= arr_end)
-            break;
-
-        Player *p = &g_game_state.players[i];
-        p->index = extract_int_value(player_start, "index", player_end);
+        if (item->type != JSON_OBJECT)
+            continue;
 
-        char *name = extract_string_value(player_start, "name", player_end);
-        if (name)
+        Player *p = &ctx->state.players[i];
+        p->index = member_int(doc, item, "index");
+        // 没有名字时保留原值
+        json_string_copy(member_of_type(doc, item, "name", JSON_STRING), p->name, sizeof(p->name));
+        p->fund = member_int(doc, item, "fund");
+        p->credit = member_int(doc, item, "credit");
+        p->location = member_int(doc, item, "location");
+        p->alive = member_bool(doc, item, "alive");
+
+        const JsonNode *prop = member_of_type(doc, item, "prop", JSON_OBJECT);
+        if (prop)
         {
-            strncpy(p->name, name, MAX_NAME_LENGTH - 1);
-            p->name[MAX_NAME_LENGTH - 1] = '\0';
-            free(name);
+            p->prop.bomb = member_int(doc, prop, "bomb");
+            p->prop.barrier = member_int(doc, prop, "barrier");
+            p->prop.robot = member_int(doc, prop, "robot");
+            p->prop.total = member_int(doc, prop, "total");
         }
 
-        p->fund = extract_int_value(player_start, "fund", player_end);
-        p->credit = extract_int_value(player_start, "credit", player_end);
-        p->location = extract_int_value(player_start, "location", player_end);
-        p->alive = extract_bool_value(player_start, "alive", player_end);
-
-        parse_player_prop(player_start, player_end, &p->prop);
-        parse_player_buff(player_start, player_end, &p->buff);
-
-        if (strcmp(p->name, "钱夫人") == 0)
-            p->color = COLOR_RED;
-        else if (strcmp(p->name, "阿土伯") == 0)
-            p->color = COLOR_GREEN;
-        else if (strcmp(p->name, "孙小美") == 0)
-            p->color = COLOR_BLUE;
-        else if (strcmp(p->name, "金贝贝") == 0)
-            p->color = COLOR_YELLOW;
-        else
-            p->color = COLOR_RESET;
+        const JsonNode *buff = member_of_type(doc, item, "buff", JSON_OBJECT);
+        if (buff)
+        {
+            p->buff.god = member_int(doc, buff, "god");
+            p->buff.prison = member_int(doc, buff, "prison");
+            p->buff.hospital = member_int(doc, buff, "hospital");
+        }
 
-        current = player_end + 1;
+        p->color = player_color_by_name(p->name);
         i++;
     }
-    g_game_state.player_count = i;
+    ctx->state.player_count = i;
 }
 
-// 解析houses对象
-void parse_and_load_houses(const char *content)
+// 解析houses对象，键为地块位置
+static void load_houses(GameContext* ctx, const JsonDocument *doc, const JsonNode *houses)
 {
-    char *houses_start = strstr(content, "\"houses\":");
-    if (!houses_start)
-        return;
-
-    char *obj_start = strchr(houses_start, '{');
-    if (!obj_start)
-        return;
-
-    char *obj_end = find_matching_brace(obj_start);
-    if (!obj_end)
-        return;
-
-    for (int i = 0; i < MAP_SIZE; i++)
+    for (int i = 0; i < ctx->board->size; i++)
     {
-        g_game_state.houses[i].owner_id = -1;
-        g_game_state.houses[i].level = 0;
+        ctx->state.houses[i].owner_id = -1;
+        ctx->state.houses[i].level = 0;
     }
 
-    char *current = obj_start + 1;
-    while (current < obj_end)
+    for (const JsonNode *house = json_first(doc, houses); house; house = json_next(doc, house))
     {
-        char *key_start = strchr(current, '"');
-        if (!key_start || key_start > obj_end)
-            break;
-        char *key_end = strchr(key_start + 1, '"');
-        if (!key_end || key_end > obj_end)
+        if (house->type != JSON_OBJECT)
             break;
 
-        int loc_len = key_end - (key_start + 1);
-        char loc_str[10] = {0};
-        strncpy(loc_str, key_start + 1, loc_len);
-        int loc = atoi(loc_str);
+        int loc = atoi(house->key);
+        if (!board_contains(ctx->board, loc))
+            continue;
 
-        char *house_obj_start = strchr(key_end, '{');
-        if (!house_obj_start || house_obj_start > obj_end)
-            break;
-        char *house_obj_end = find_matching_brace(house_obj_start);
-        if (!house_obj_end || house_obj_end > obj_end)
-            break;
+        ctx->state.houses[loc].level = member_int(doc, house, "level");
 
-        if (loc >= 0 && loc < MAP_SIZE)
+        // 先尝试作为字符串解析owner（玩家名称）
+        bool found = false;
+        char owner_name[MAX_NAME_LENGTH];
+        if (json_string_copy(member_of_type(doc, house, "owner", JSON_STRING), owner_name, sizeof(owner_name)))
         {
-            g_game_state.houses[loc].level = extract_int_value(house_obj_start, "level", house_obj_end);
-
-            // 先尝试作为字符串解析owner（玩家名称）
-            char *owner_name = extract_string_value(house_obj_start, "owner", house_obj_end);
-            if (owner_name)
+            for (int i = 0; i < ctx->state.player_count; i++)
             {
-                // 找到匹配的玩家名称
-                bool found = false;
-                for (int i = 0; i < g_game_state.player_count; i++)
-                {
-                    if (strcmp(g_game_state.players[i].name, owner_name) == 0)
-                    {
-                        g_game_state.houses[loc].owner_id = g_game_state.players[i].index;
-                        found = true;
-                        break;
-                    }
-                }
-                free(owner_name);
-
-                // 如果没找到匹配的玩家名，尝试作为整数解析
-                if (!found)
+                if (strcmp(ctx->state.players[i].name, owner_name) == 0)
                 {
-                    int owner_id = extract_int_value(house_obj_start, "owner", house_obj_end);
-                    if (owner_id >= 0 && owner_id < g_game_state.player_count)
-                    {
-                        g_game_state.houses[loc].owner_id = owner_id;
-                    }
-                }
-            }
-            else
-            {
-                // 如果不是字符串，尝试作为整数解析（玩家索引）
-                int owner_id = extract_int_value(house_obj_start, "owner", house_obj_end);
-                if (owner_id >= 0 && owner_id < g_game_state.player_count)
-                {
-                    g_game_state.houses[loc].owner_id = owner_id;
+                    ctx->state.houses[loc].owner_id = ctx->state.players[i].index;
+                    found = true;
+                    break;
                 }
             }
         }
-        current = house_obj_end + 1;
-    }
-}
 
-// 解析placed_prop对象
-void parse_and_load_placed_prop(const char *content)
-{
-    char *placed_prop_start = strstr(content, "\"placed_prop\":");
-    if (!placed_prop_start)
-        return;
-
-    char *obj_start = strchr(placed_prop_start, '{');
-    if (!obj_start)
-        return;
-
-    char *obj_end = find_matching_brace(obj_start);
-    if (!obj_end)
-        return;
-
-    memset(g_game_state.placed_prop.bomb, 0, sizeof(g_game_state.placed_prop.bomb));
-    memset(g_game_state.placed_prop.barrier, 0, sizeof(g_game_state.placed_prop.barrier));
-
-    char *bomb_start = strstr(obj_start, "\"bomb\":");
-    if (bomb_start && bomb_start < obj_end)
-    {
-        char *arr_start = strchr(bomb_start, '[');
-        char *arr_end = strchr(bomb_start, ']');
-        if (arr_start && arr_end)
+        // 否则作为整数解析（玩家索引）
+        if (!found)
         {
-            char *p = arr_start + 1;
-            while (p < arr_end)
+            int owner_id = member_int(doc, house, "owner");
+            if (owner_id >= 0 && owner_id < ctx->state.player_count)
             {
-                int loc = atoi(p);
-                if (loc >= 0 && loc < MAP_SIZE)
-                    g_game_state.placed_prop.bomb[loc] = 1;
-                while (*p && *p != ',' && p < arr_end)
-                    p++;
-                if (*p == ',')
-                    p++;
+                ctx->state.houses[loc].owner_id = owner_id;
             }
         }
     }
+}
 
-    char *barrier_start = strstr(obj_start, "\"barrier\":");
-    if (barrier_start && barrier_start < obj_end)
+static void load_positions(const GameContext* ctx, const JsonDocument *doc, const JsonNode *array, TileSet *tiles)
+{
+    // 忽略地图外的位置
+    for (const JsonNode *item = json_first(doc, array); item; item = json_next(doc, item))
     {
-        char *arr_start = strchr(barrier_start, '[');
-        char *arr_end = strchr(barrier_start, ']');
-        if (arr_start && arr_end)
-        {
-            char *p = arr_start + 1;
-            while (p < arr_end)
-            {
-                int loc = atoi(p);
-                if (loc >= 0 && loc < MAP_SIZE)
-                    g_game_state.placed_prop.barrier[loc] = 1;
-                while (*p && *p != ',' && p < arr_end)
-                    p++;
-                if (*p == ',')
-                    p++;
-            }
-        }
+        int location = node_int(item);
+        if (board_contains(ctx->board, location))
+            tile_set_add(tiles, location);
     }
 }
 
-// 解析game信息
-void parse_and_load_game_info(const char *content)
+// 解析placed_prop对象
+static void load_placed_prop(GameContext* ctx, const JsonDocument *doc, const JsonNode *placed_prop)
 {
-    char *game_start = strstr(content, "\"game\":");
-    if (!game_start)
-        return;
+    tile_set_clear_all(&ctx->state.placed_prop.bomb);
+    tile_set_clear_all(&ctx->state.placed_prop.barrier);
 
-    char *obj_start = strchr(game_start, '{');
-    if (!obj_start)
-        return;
+    load_positions(ctx, doc, member_of_type(doc, placed_prop, "bomb", JSON_ARRAY), &ctx->state.placed_prop.bomb);
+    load_positions(ctx, doc, member_of_type(doc, placed_prop, "barrier", JSON_ARRAY), &ctx->state.placed_prop.barrier);
+}
 
-    char *obj_end = find_matching_brace(obj_start);
-    if (!obj_end)
+// 解析rng对象，缺少种子时保留当前发生器
+static void load_rng(GameContext* ctx, const JsonDocument *doc, const JsonNode *rng)
+{
+    const JsonNode *seed = json_member(doc, rng, "seed");
+    if (!seed)
         return;
 
-    g_game_state.game.now_player_id = extract_int_value(obj_start, "now_player", obj_end);
-    g_game_state.game.next_player_id = extract_int_value(obj_start, "next_player", obj_end);
-    g_game_state.game.started = extract_bool_value(obj_start, "started", obj_end);
-    g_game_state.game.ended = extract_bool_value(obj_start, "ended", obj_end);
-    g_game_state.game.winner_id = extract_int_value(obj_start, "winner", obj_end);
+    const JsonNode *stream = json_member(doc, rng, "stream");
+    const JsonNode *draws = json_member(doc, rng, "draws");
+    unsigned long long seed_value = seed->type == JSON_NUMBER ? strtoull(seed->text, NULL, 10) : 0;
+    unsigned long long stream_value = (stream && stream->type == JSON_NUMBER) ? strtoull(stream->text, NULL, 10) : 0;
+    unsigned long long draws_value = (draws && draws->type == JSON_NUMBER) ? strtoull(draws->text, NULL, 10) : 0;
+
+    rng_restore(&ctx->rng, seed_value, stream_value, draws_value);
 }
 
-int load_game_preset(const char *filename)
+// 读取整个文本文件，返回以 '\0' 结尾的内容（调用者负责 free），失败返回 NULL
+char *read_text_file(const char *filename, long *length_out)
 {
     FILE *file = fopen(filename, "r");
     if (!file)
     {
-        return -1;
+        return NULL;
     }
 
     fseek(file, 0, SEEK_END);
@@ -577,25 +363,102 @@ int load_game_preset(const char *filename)
     if (!content)
     {
         fclose(file);
-        return -1;
+        return NULL;
     }
-    fread(content, 1, length, file);
+    length = (long)fread(content, 1, length, file);
     content[length] = '\0';
 
     fclose(file);
 
-    parse_and_load_players(content);
-    parse_and_load_houses(content);
-    parse_and_load_god(content);
-    parse_and_load_placed_prop(content);
-    parse_and_load_game_info(content);
+    if (length_out)
+    {
+        *length_out = length;
+    }
+    return content;
+}
 
-    free(content);
+// 从内存中的 JSON 文本加载游戏状态；格式错误时不修改状态，错误位置写入 error（可为 NULL）
+int load_game_from_json(GameContext* ctx, const char *content, JsonError *error)
+{
+    JsonDocument doc;
+    if (!json_parse(&doc, content, error))
+    {
+        return -1;
+    }
+
+    const JsonNode *root = &doc.nodes[0];
+    if (root->type != JSON_OBJECT)
+    {
+        if (error)
+        {
+            error->line = 1;
+            error->column = 1;
+            error->message = "顶层应为对象";
+        }
+        json_free(&doc);
+        return -1;
+    }
 
-    if (g_game_state.player_count > 0)
+    // 文件中缺少的部分保持原状态；玩家须先于房产加载（房产按玩家名关联）
+    const JsonNode *players = member_of_type(&doc, root, "players", JSON_ARRAY);
+    if (players)
     {
-        g_game_state.game.started = true;
+        load_players(ctx, &doc, players);
+        occupancy_rebuild(ctx);
+    }
+
+    const JsonNode *houses = member_of_type(&doc, root, "houses", JSON_OBJECT);
+    if (houses)
+    {
+        load_houses(ctx, &doc, houses);
+        ownership_rebuild(ctx);
+    }
+
+    const JsonNode *god = member_of_type(&doc, root, "god", JSON_OBJECT);
+    if (god)
+    {
+        ctx->state.god.spawn_cooldown = member_int(&doc, god, "spawn_cooldown");
+        ctx->state.god.location = member_int(&doc, god, "location");
+        ctx->state.god.duration = member_int(&doc, god, "duration");
+    }
+
+    const JsonNode *placed_prop = member_of_type(&doc, root, "placed_prop", JSON_OBJECT);
+    if (placed_prop)
+        load_placed_prop(ctx, &doc, placed_prop);
+
+    const JsonNode *game = member_of_type(&doc, root, "game", JSON_OBJECT);
+    if (game)
+    {
+        ctx->state.game.now_player_id = member_int(&doc, game, "now_player");
+        ctx->state.game.next_player_id = member_int(&doc, game, "next_player");
+        ctx->state.game.started = member_bool(&doc, game, "started");
+        ctx->state.game.ended = member_bool(&doc, game, "ended");
+        ctx->state.game.winner_id = member_int(&doc, game, "winner");
+    }
+
+    const JsonNode *rng = member_of_type(&doc, root, "rng", JSON_OBJECT);
+    if (rng)
+        load_rng(ctx, &doc, rng);
+
+    json_free(&doc);
+
+    if (ctx->state.player_count > 0)
+    {
+        ctx->state.game.started = true;
     }
 
     return 0;
-}
\ No newline at end of file
+}
+
+int load_game_preset(GameContext* ctx, const char *filename)
+{
+    char *content = read_text_file(filename, NULL);
+    if (!content)
+    {
+        return -1;
+    }
+
+    int result = load_game_from_json(ctx, content, NULL);
+    free(content);
+    return result;
+}
@@ -2,9 +2,22 @@
 #define JSON_SERIALIZER_H
 
 #include "../game/game_types.h"
+#include "../game/game_context.h"
+#include "../utils/json_reader.h"
+#include "../utils/json_writer.h"
+#include <stddef.h>
 
 // JSON序列化函数声明
-void save_game_dump(const char* filename);
-int load_game_preset(const char* filename);
+// 保存：先整体生成到缓冲区，再经临时文件改名一次性替换目标文件，成功返回 0
+int save_game_dump(const GameContext* ctx, const char* filename);
+int save_game_dump_with_style(const GameContext* ctx, const char* filename, JsonStyle style);
+// 生成到调用方缓冲区，返回完整长度（不含 '\0'）；返回值 >= size 表示缓冲区不够
+size_t save_game_to_buffer(const GameContext* ctx, char* buffer, size_t size, JsonStyle style);
+// 写临时文件并改名覆盖 filename，成功返回 0；改名之后的目录落盘只是尽力而为，不影响返回值
+int write_file_atomic(const char* filename, const void* data, size_t size);
+
+int load_game_preset(GameContext* ctx, const char* filename);
+int load_game_from_json(GameContext* ctx, const char* content, JsonError* error);
+char* read_text_file(const char* filename, long* length);
 
 #endif // JSON_SERIALIZER_H
\ No newline at end of file
@@ -0,0 +1,151 @@
+#define _POSIX_C_SOURCE 200112L
+
+#include "output.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+// 非终端输出时 stdout 的缓冲区大小
+#define OUTPUT_STDIO_BUFFER_SIZE (64 * 1024)
+
+static TerminalCaps s_caps;
+static bool s_caps_ready = false;
+static const OutputBackend* s_backend = NULL;
+
+// ---- stdio 后端（ANSI 与纯文本共用，仅能力标志不同） ----
+
+static void stdio_vprint(const char* format, va_list args) {
+    vfprintf(stdout, format, args);
+}
+
+static void stdio_write_text(const char* data, size_t len) {
+    fwrite(data, 1, len, stdout);
+}
+
+static void stdio_write_frame(const char* data, size_t len) {
+    fflush(stdout);
+    size_t off = 0;
+    while (off < len) {
+        ssize_t n = write(STDOUT_FILENO, data + off, len - off);
+        if (n <= 0) break;
+        off += (size_t)n;
+    }
+}
+
+static void stdio_flush(void) {
+    fflush(stdout);
+}
+
+// ---- 空后端：丢弃所有输出 ----
+
+static void null_vprint(const char* format, va_list args) {
+    (void)format;
+    (void)args;
+}
+
+static void null_write(const char* data, size_t len) {
+    (void)data;
+    (void)len;
+}
+
+static void null_flush(void) {
+}
+
+static OutputBackend s_ansi_backend = {
+    OUTPUT_BACKEND_ANSI, "ansi", true, false,
+    stdio_vprint, stdio_write_text, stdio_write_frame, stdio_flush
+};
+
+static const OutputBackend s_plain_backend = {
+    OUTPUT_BACKEND_PLAIN, "plain", false, false,
+    stdio_vprint, stdio_write_text, stdio_write_frame, stdio_flush
+};
+
+static const OutputBackend s_null_backend = {
+    OUTPUT_BACKEND_NULL, "null", false, false,
+    null_vprint, null_write, null_write, null_flush
+};
+
+static void detect_caps(void) {
+    if (s_caps_ready) return;
+
+    s_caps.is_tty = isatty(STDOUT_FILENO) != 0;
+
+    // 不支持 ANSI 的终端类型，或明确禁用了颜色
+    const char* term = getenv("TERM");
+    const char* no_color = getenv("NO_COLOR");
+    s_caps.ansi = term != NULL &&
+                  strcmp(term, "dumb") != 0 &&
+                  strcmp(term, "unknown") != 0 &&
+                  !(no_color && no_color[0] != '\0');
+
+    s_caps_ready = true;
+}
+
+void output_select(OutputBackendKind kind) {
+    detect_caps();
+
+    if (kind == OUTPUT_BACKEND_AUTO) {
+        kind = s_caps.ansi ? OUTPUT_BACKEND_ANSI : OUTPUT_BACKEND_PLAIN;
+    }
+    switch (kind) {
+        case OUTPUT_BACKEND_ANSI:
+            // 光标定位只在真正的终端上使用，重定向到文件时保持整屏输出
+            s_ansi_backend.cursor = s_caps.is_tty;
+            s_backend = &s_ansi_backend;
+            break;
+        case OUTPUT_BACKEND_NULL:
+            s_backend = &s_null_backend;
+            break;
+        default:
+            s_backend = &s_plain_backend;
+            break;
+    }
+}
+
+void output_init(OutputBackendKind kind) {
+    detect_caps();
+    if (!s_caps.is_tty) {
+        setvbuf(stdout, NULL, _IOFBF, OUTPUT_STDIO_BUFFER_SIZE);
+    }
+    output_select(kind);
+}
+
+bool output_parse_backend(const char* name, OutputBackendKind* kind) {
+    if (strcmp(name, "auto") == 0) *kind = OUTPUT_BACKEND_AUTO;
+    else if (strcmp(name, "ansi") == 0) *kind = OUTPUT_BACKEND_ANSI;
+    else if (strcmp(name, "plain") == 0) *kind = OUTPUT_BACKEND_PLAIN;
+    else if (strcmp(name, "null") == 0) *kind = OUTPUT_BACKEND_NULL;
+    else return false;
+    return true;
+}
+
+const TerminalCaps* output_caps(void) {
+    detect_caps();
+    return &s_caps;
+}
+
+const OutputBackend* output_backend(void) {
+    if (!s_backend) output_select(OUTPUT_BACKEND_AUTO);
+    return s_backend;
+}
+
+void output_printf(const char* format, ...) {
+    va_list args;
+    va_start(args, format);
+    output_backend()->vprint(format, args);
+    va_end(args);
+}
+
+void output_write(const char* data, size_t len) {
+    output_backend()->write_text(data, len);
+}
+
+void output_write_frame(const char* data, size_t len) {
+    output_backend()->write_frame(data, len);
+}
+
+void output_flush(void) {
+    output_backend()->flush();
+}
@@ -0,0 +1,56 @@
+#ifndef OUTPUT_H
+#define OUTPUT_H
+
+#include <stdarg.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+// 输出后端类型
+typedef enum {
+    OUTPUT_BACKEND_AUTO,   // 根据终端能力自动选择 ANSI 或纯文本
+    OUTPUT_BACKEND_ANSI,   // 带颜色和光标控制序列
+    OUTPUT_BACKEND_PLAIN,  // 纯文本，不输出任何转义序列
+    OUTPUT_BACKEND_NULL    // 丢弃所有输出，用于批量运行
+} OutputBackendKind;
+
+// 启动时检测一次的终端能力
+typedef struct {
+    bool is_tty;   // 标准输出是否为终端
+    bool ansi;     // TERM 支持 ANSI 且未设置 NO_COLOR
+} TerminalCaps;
+
+// 输出后端：所有游戏输出经由当前后端写出
+typedef struct {
+    OutputBackendKind kind;
+    const char* name;
+    bool ansi;      // 是否输出颜色等转义序列
+    bool cursor;    // 是否支持光标定位（增量重绘）
+    void (*vprint)(const char* format, va_list args);   // 格式化文本，经 stdio 缓冲
+    void (*write_text)(const char* data, size_t len);
+    void (*write_frame)(const char* data, size_t len);  // 整帧内容，先刷新 stdio 再一次写出
+    void (*flush)(void);
+} OutputBackend;
+
+// 检测终端能力并选择后端，应在任何输出之前调用一次
+// 标准输出不是终端时改为全缓冲
+void output_init(OutputBackendKind kind);
+
+// 只切换后端，不改变 stdout 缓冲方式（供无头模拟等场景使用）
+void output_select(OutputBackendKind kind);
+
+// 按名称解析后端类型（auto/ansi/plain/null），无法识别返回 false
+bool output_parse_backend(const char* name, OutputBackendKind* kind);
+
+const TerminalCaps* output_caps(void);
+const OutputBackend* output_backend(void);
+
+static inline bool output_ansi_enabled(void) {
+    return output_backend()->ansi;
+}
+
+void output_printf(const char* format, ...);
+void output_write(const char* data, size_t len);
+void output_write_frame(const char* data, size_t len);
+void output_flush(void);
+
+#endif // OUTPUT_H
@@ -0,0 +1,124 @@
+#define _POSIX_C_SOURCE 200112L
+
+#include "renderer.h"
+#include "colors.h"
+#include "output.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/ioctl.h>
+#include <unistd.h>
+
+// 地图下方至少保留的消息行数，终端过小时退化为整屏重绘
+#define RENDERER_MIN_MESSAGE_LINES 4
+// 地图行右侧“地段 2”标注占用的显示宽度
+#define RENDERER_LABEL_WIDTH 10
+
+// 是否设置过滚动区域，程序退出时需要恢复
+static bool s_scroll_region_set = false;
+
+static void reset_scroll_region(void) {
+    if (!s_scroll_region_set) return;
+    // 保存光标、取消滚动区域、恢复光标，避免退出后光标跳回屏幕顶部
+    static const char seq[] = "\x1B" "7" "\x1B[r" "\x1B" "8";
+    output_write_frame(seq, sizeof(seq) - 1);
+    s_scroll_region_set = false;
+}
+
+static bool query_terminal_size(int* rows, int* cols) {
+    struct winsize ws;
+    if (ioctl(STDOUT_FILENO, TIOCGWINSZ, &ws) != 0 || ws.ws_row == 0 || ws.ws_col == 0) {
+        return false;
+    }
+    *rows = ws.ws_row;
+    *cols = ws.ws_col;
+    return true;
+}
+
+static bool cell_equal(const MapCell* a, const MapCell* b) {
+    if (a->symbol != b->symbol) return false;
+    if (a->color == b->color) return true;
+    return a->color && b->color && strcmp(a->color, b->color) == 0;
+}
+
+static void draw_full_fallback(Renderer* renderer, GameContext* ctx) {
+    reset_scroll_region();
+    renderer->valid = false;
+    output_printf("%s", CLEAR_SCREEN);
+    display_map(ctx);
+}
+
+void renderer_init(Renderer* renderer) {
+    static bool exit_hook_registered = false;
+
+    memset(renderer, 0, sizeof(*renderer));
+    renderer->incremental = output_backend()->cursor;
+    renderer->valid = false;
+
+    if (renderer->incremental && !exit_hook_registered) {
+        atexit(reset_scroll_region);
+        exit_hook_registered = true;
+    }
+}
+
+void renderer_invalidate(Renderer* renderer) {
+    renderer->valid = false;
+}
+
+void renderer_draw(Renderer* renderer, GameContext* ctx) {
+    if (!renderer->incremental) {
+        output_printf("%s", CLEAR_SCREEN);
+        display_map(ctx);
+        return;
+    }
+
+    const Board* board = ctx->board;
+    int frame_lines = map_frame_lines(board);
+    int rows, cols;
+    if (!query_terminal_size(&rows, &cols) ||
+        rows < frame_lines + RENDERER_MIN_MESSAGE_LINES ||
+        cols < board->cols + RENDERER_LABEL_WIDTH) {
+        draw_full_fallback(renderer, ctx);
+        return;
+    }
+    if (rows != renderer->term_rows || cols != renderer->term_cols) {
+        renderer->valid = false;
+    }
+
+    int cell_count = board->rows * board->cols;
+    MapCell cells[BOARD_MAX_CELLS];
+    FrameBuffer fb;
+    build_map_cells(ctx, cells);
+    frame_init(&fb);
+
+    if (!renderer->valid) {
+        // 整屏重绘，并把地图下方设为滚动区域，消息滚动时地图保持不动
+        frame_puts(&fb, "\x1B[r");
+        frame_puts(&fb, CLEAR_SCREEN);
+        compose_map_frame(board, cells, &fb);
+        frame_printf(&fb, "\x1B[%d;%dr", frame_lines + 1, rows);
+        s_scroll_region_set = true;
+    } else {
+        // 只输出变化的格子，同一行连续变化的格子不重复定位光标
+        const char* reset = COLOR_RESET;
+        int next_cell = -1;
+        for (int cell = 0; cell < cell_count; cell++) {
+            if (cell_equal(&cells[cell], &renderer->prev[cell])) continue;
+            if (cell != next_cell || cell % board->cols == 0) {
+                // 第一行为上方标注，地图从第 2 行开始
+                frame_printf(&fb, "\x1B[%d;%dH", cell / board->cols + 2, cell % board->cols + 1);
+            }
+            map_cell_append(&fb, &cells[cell], reset);
+            next_cell = cell + 1;
+        }
+    }
+
+    // 清除上一轮的消息区域，光标停在地图下方
+    frame_printf(&fb, "\x1B[%d;1H\x1B[J", frame_lines + 1);
+    frame_flush(&fb);
+
+    memcpy(renderer->prev, cells, sizeof(MapCell) * (size_t)cell_count);
+    renderer->valid = true;
+    renderer->term_rows = rows;
+    renderer->term_cols = cols;
+}
@@ -0,0 +1,27 @@
+#ifndef RENDERER_H
+#define RENDERER_H
+
+#include <stdbool.h>
+#include "../game/game_context.h"
+#include "../game/map.h"
+
+// 地图渲染器：记住上一帧，只重绘发生变化的格子
+// 屏幕顶部固定显示地图，其下方设置为滚动区域用于消息和命令提示；
+// 输出后端不支持光标定位时（非终端、TERM=dumb、NO_COLOR、plain/null 后端）退化为整屏清除重绘
+typedef struct {
+    bool incremental;   // 是否启用增量重绘
+    bool valid;         // prev 是否与屏幕上的内容一致
+    int term_rows;      // 上一帧时的终端尺寸，尺寸变化时整屏重绘
+    int term_cols;
+    MapCell prev[BOARD_MAX_CELLS];
+} Renderer;
+
+void renderer_init(Renderer* renderer);
+
+// 清屏并绘制地图，结束后光标位于地图下方的第一行
+void renderer_draw(Renderer* renderer, GameContext* ctx);
+
+// 下一帧强制整屏重绘
+void renderer_invalidate(Renderer* renderer);
+
+#endif // RENDERER_H
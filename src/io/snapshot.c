@@ -0,0 +1,216 @@
+#define _POSIX_C_SOURCE 200112L
+
+#include "snapshot.h"
+#include "json_serializer.h"
+#include "../game/player.h"
+#include "../game/tile_set.h"
+#include "../game/ownership.h"
+#include "../game/occupancy.h"
+#include <stdio.h>
+#include <string.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// 负载校验：FNV-1a 32 位
+static uint32_t snapshot_checksum(const void* data, size_t size) {
+    const unsigned char* bytes = (const unsigned char*)data;
+    uint32_t hash = 2166136261u;
+    for (size_t i = 0; i < size; i++) {
+        hash ^= bytes[i];
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+bool snapshot_supported(const GameContext* ctx) {
+    return ctx->board->size == SNAPSHOT_TILES && ctx->state.player_count <= SNAPSHOT_PLAYERS;
+}
+
+void snapshot_encode(const GameContext* ctx, GameSnapshot* snapshot) {
+    const GameState* state = &ctx->state;
+    // 先整体清零，结构体内的填充字节也参与校验
+    memset(snapshot, 0, sizeof(*snapshot));
+    SnapshotPayload* out = &snapshot->payload;
+
+    out->rng_seed = ctx->rng.seed;
+    out->rng_stream = ctx->rng.stream;
+    out->rng_draws = ctx->rng.draws;
+    out->player_count = state->player_count;
+    out->now_player_id = state->game.now_player_id;
+    out->next_player_id = state->game.next_player_id;
+    out->last_player_id = state->game.last_player_id;
+    out->started = state->game.started;
+    out->ended = state->game.ended;
+    out->winner_id = state->game.winner_id;
+    out->interaction_pending = state->game.interaction_pending;
+    out->pending_interaction_player_id = state->game.pending_interaction_player_id;
+    out->god_spawn_cooldown = state->god.spawn_cooldown;
+    out->god_location = state->god.location;
+    out->god_duration = state->god.duration;
+
+    for (int i = 0; i < SNAPSHOT_PLAYERS; i++) {
+        const Player* p = &state->players[i];
+        SnapshotPlayer* sp = &out->players[i];
+        sp->index = p->index;
+        memcpy(sp->name, p->name, MAX_NAME_LENGTH);
+        sp->fund = p->fund;
+        sp->credit = p->credit;
+        sp->location = p->location;
+        sp->alive = p->alive;
+        sp->bomb = p->prop.bomb;
+        sp->barrier = p->prop.barrier;
+        sp->robot = p->prop.robot;
+        sp->total = p->prop.total;
+        sp->god = p->buff.god;
+        sp->prison = p->buff.prison;
+        sp->hospital = p->buff.hospital;
+    }
+
+    for (int i = 0; i < SNAPSHOT_TILES; i++) {
+        out->houses[i].id = state->houses[i].id;
+        out->houses[i].price = state->houses[i].price;
+        out->houses[i].level = state->houses[i].level;
+        out->houses[i].owner_id = state->houses[i].owner_id;
+        out->bomb[i] = tile_set_has(&state->placed_prop.bomb, i);
+        out->barrier[i] = tile_set_has(&state->placed_prop.barrier, i);
+    }
+
+    SnapshotHeader* header = &snapshot->header;
+    memcpy(header->magic, SNAPSHOT_MAGIC, 4);
+    header->version = SNAPSHOT_VERSION;
+    header->byte_order = SNAPSHOT_BYTE_ORDER;
+    header->header_size = sizeof(SnapshotHeader);
+    header->payload_size = sizeof(SnapshotPayload);
+    header->checksum = snapshot_checksum(out, sizeof(*out));
+}
+
+int snapshot_decode(GameContext* ctx, const void* data, size_t size) {
+    if (size < sizeof(GameSnapshot)) {
+        return -1;
+    }
+    const GameSnapshot* snapshot = (const GameSnapshot*)data;
+    const SnapshotHeader* header = &snapshot->header;
+    const SnapshotPayload* in = &snapshot->payload;
+    if (memcmp(header->magic, SNAPSHOT_MAGIC, 4) != 0 ||
+        header->version != SNAPSHOT_VERSION ||
+        header->byte_order != SNAPSHOT_BYTE_ORDER ||
+        header->header_size != sizeof(SnapshotHeader) ||
+        header->payload_size != sizeof(SnapshotPayload) ||
+        header->checksum != snapshot_checksum(in, sizeof(*in))) {
+        return -1;
+    }
+    if (in->player_count < 0 || in->player_count > SNAPSHOT_PLAYERS || ctx->board->size != SNAPSHOT_TILES) {
+        return -1;
+    }
+
+    GameState* state = &ctx->state;
+    rng_restore(&ctx->rng, in->rng_seed, in->rng_stream, in->rng_draws);
+    state->player_count = in->player_count;
+    state->game.now_player_id = in->now_player_id;
+    state->game.next_player_id = in->next_player_id;
+    state->game.last_player_id = in->last_player_id;
+    state->game.started = in->started != 0;
+    state->game.ended = in->ended != 0;
+    state->game.winner_id = in->winner_id;
+    state->game.interaction_pending = in->interaction_pending != 0;
+    state->game.pending_interaction_player_id = in->pending_interaction_player_id;
+    state->god.spawn_cooldown = in->god_spawn_cooldown;
+    state->god.location = in->god_location;
+    state->god.duration = in->god_duration;
+
+    for (int i = 0; i < SNAPSHOT_PLAYERS; i++) {
+        const SnapshotPlayer* sp = &in->players[i];
+        Player* p = &state->players[i];
+        p->index = sp->index;
+        memcpy(p->name, sp->name, MAX_NAME_LENGTH);
+        p->name[MAX_NAME_LENGTH - 1] = '\0';
+        p->color = player_color_by_name(p->name);
+        p->fund = sp->fund;
+        p->credit = sp->credit;
+        p->location = sp->location;
+        p->alive = sp->alive != 0;
+        p->prop.bomb = sp->bomb;
+        p->prop.barrier = sp->barrier;
+        p->prop.robot = sp->robot;
+        p->prop.total = sp->total;
+        p->buff.god = sp->god;
+        p->buff.prison = sp->prison;
+        p->buff.hospital = sp->hospital;
+    }
+
+    tile_set_clear_all(&state->placed_prop.bomb);
+    tile_set_clear_all(&state->placed_prop.barrier);
+    for (int i = 0; i < SNAPSHOT_TILES; i++) {
+        state->houses[i].id = in->houses[i].id;
+        state->houses[i].price = in->houses[i].price;
+        state->houses[i].level = in->houses[i].level;
+        state->houses[i].owner_id = in->houses[i].owner_id;
+        if (in->bomb[i]) tile_set_add(&state->placed_prop.bomb, i);
+        if (in->barrier[i]) tile_set_add(&state->placed_prop.barrier, i);
+    }
+    ownership_rebuild(ctx);
+    occupancy_rebuild(ctx);
+    return 0;
+}
+
+int save_game_snapshot(const GameContext* ctx, const char* filename) {
+    if (!snapshot_supported(ctx)) {
+        return -1;
+    }
+    GameSnapshot snapshot;
+    snapshot_encode(ctx, &snapshot);
+
+    return write_file_atomic(filename, &snapshot, sizeof(snapshot));
+}
+
+int load_game_snapshot(GameContext* ctx, const char* filename) {
+    int fd = open(filename, O_RDONLY);
+    if (fd < 0) {
+        return -1;
+    }
+    struct stat st;
+    if (fstat(fd, &st) != 0 || (size_t)st.st_size < sizeof(GameSnapshot)) {
+        close(fd);
+        return -1;
+    }
+    void* data = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (data == MAP_FAILED) {
+        return -1;
+    }
+    int result = snapshot_decode(ctx, data, (size_t)st.st_size);
+    munmap(data, (size_t)st.st_size);
+    return result;
+}
+
+bool is_snapshot_file(const char* filename) {
+    char magic[4];
+    FILE* file = fopen(filename, "rb");
+    if (!file) {
+        return false;
+    }
+    bool match = fread(magic, 1, sizeof(magic), file) == sizeof(magic) &&
+                 memcmp(magic, SNAPSHOT_MAGIC, 4) == 0;
+    fclose(file);
+    return match;
+}
+
+int convert_game_file(const char* input, const char* output, JsonStyle style) {
+    // 与终端游戏相同的初始上下文，JSON 中未给出的字段取默认值
+    static GameContext ctx;
+    game_context_init(&ctx, 12345, 0);
+
+    if (is_snapshot_file(input)) {
+        if (load_game_snapshot(&ctx, input) != 0) {
+            return -1;
+        }
+        return save_game_dump_with_style(&ctx, output, style);
+    }
+
+    if (load_game_preset(&ctx, input) != 0) {
+        return -1;
+    }
+    return save_game_snapshot(&ctx, output);
+}
@@ -0,0 +1,87 @@
+#ifndef SNAPSHOT_H
+#define SNAPSHOT_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "../game/game_context.h"
+
+// 二进制快照：定长布局，整块写入，加载时 mmap 后校验即可直接读取，无需解析
+//
+// 文件 = SnapshotHeader + SnapshotPayload，所有字段均为定宽整数，按本机字节序存放；
+// 字节序标记不符的文件视为无效（需要时先用 JSON 转换）。
+// 布局有任何变化都必须提升 SNAPSHOT_VERSION。
+#define SNAPSHOT_MAGIC "RSNP"
+#define SNAPSHOT_VERSION 1
+#define SNAPSHOT_BYTE_ORDER 0x01020304u
+#define SNAPSHOT_TILES 70  // 定长布局按经典地图的格子数存放，其他尺寸的地图只能保存为 JSON
+#define SNAPSHOT_PLAYERS 4 // 同理，玩家数超过 4 的对局只能保存为 JSON
+
+typedef struct {
+    char magic[4];          // "RSNP"
+    uint32_t version;       // SNAPSHOT_VERSION
+    uint32_t byte_order;    // 写入方看到的 SNAPSHOT_BYTE_ORDER
+    uint32_t header_size;   // sizeof(SnapshotHeader)
+    uint32_t payload_size;  // sizeof(SnapshotPayload)
+    uint32_t checksum;      // 负载的 FNV-1a 校验值
+} SnapshotHeader;
+
+typedef struct {
+    int32_t index;
+    char name[MAX_NAME_LENGTH];
+    int32_t fund;
+    int32_t credit;
+    int32_t location;
+    int32_t alive;
+    int32_t bomb, barrier, robot, total;  // 道具
+    int32_t god, prison, hospital;        // 状态
+} SnapshotPlayer;
+
+typedef struct {
+    int32_t id;
+    int32_t price;
+    int32_t level;
+    int32_t owner_id;
+} SnapshotHouse;
+
+typedef struct {
+    uint64_t rng_seed;
+    uint64_t rng_stream;
+    uint64_t rng_draws;
+    int32_t player_count;
+    int32_t now_player_id;
+    int32_t next_player_id;
+    int32_t last_player_id;
+    int32_t started;
+    int32_t ended;
+    int32_t winner_id;
+    int32_t interaction_pending;
+    int32_t pending_interaction_player_id;
+    int32_t god_spawn_cooldown;
+    int32_t god_location;
+    int32_t god_duration;
+    SnapshotPlayer players[SNAPSHOT_PLAYERS];
+    SnapshotHouse houses[SNAPSHOT_TILES];
+    uint8_t bomb[SNAPSHOT_TILES];     // 1 表示该位置有炸弹
+    uint8_t barrier[SNAPSHOT_TILES];  // 1 表示该位置有路障
+} SnapshotPayload;
+
+typedef struct {
+    SnapshotHeader header;
+    SnapshotPayload payload;
+} GameSnapshot;
+
+// 内存中编码/解码，供批量保存检查点使用；解码成功返回 0
+// 只支持 SNAPSHOT_TILES 格的地图和至多 SNAPSHOT_PLAYERS 位玩家，编码前用 snapshot_supported 检查
+bool snapshot_supported(const GameContext* ctx);
+void snapshot_encode(const GameContext* ctx, GameSnapshot* snapshot);
+int snapshot_decode(GameContext* ctx, const void* data, size_t size);
+
+// 文件读写，成功返回 0
+int save_game_snapshot(const GameContext* ctx, const char* filename);
+int load_game_snapshot(GameContext* ctx, const char* filename);
+bool is_snapshot_file(const char* filename);
+
+// JSON 存档与二进制快照互转，按输入文件内容自动判断方向；style 为写出 JSON 时的格式
+int convert_game_file(const char* input, const char* output, JsonStyle style);
+
+#endif // SNAPSHOT_H
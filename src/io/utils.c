@@ -1,9 +1,31 @@
 #include "utils.h"
+#include "output.h"
+#include "journal.h"
 #include <stdio.h>
+#include <stdarg.h>
 
 void wait_for_enter() {
-    printf("\n按 Enter 键继续...");
+    output_printf("\n按 Enter 键继续...");
     // 清除输入缓冲区直到换行符
     int c;
     while ((c = getchar()) != '\n' && c != EOF);
 }
+
+char* read_prompt_input(GameContext* ctx, PromptKind kind, char* buffer, int size) {
+    char* answer = ctx->io.read_prompt ? ctx->io.read_prompt(ctx, kind, buffer, size)
+                                       : fgets(buffer, size, stdin);
+    if (ctx->io.journal) {
+        journal_record_prompt(ctx->io.journal, kind, answer);
+    }
+    return answer;
+}
+
+void prompt_printf(GameContext* ctx, const char* format, ...) {
+    if (!ctx->io.echo_prompts) {
+        return;
+    }
+    va_list args;
+    va_start(args, format);
+    output_backend()->vprint(format, args);
+    va_end(args);
+}
@@ -1,6 +1,12 @@
 #ifndef UTILS_H
 #define UTILS_H
 
+#include "../game/game_context.h"
+
 void wait_for_enter();
 
+// 交互提示的输入输出，由上下文中的钩子决定去向（默认分别为 stdin 和 stdout）
+char* read_prompt_input(GameContext* ctx, PromptKind kind, char* buffer, int size);
+void prompt_printf(GameContext* ctx, const char* format, ...);
+
 #endif // UTILS_H
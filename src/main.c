@@ -1,24 +1,168 @@
 #include "io/command_processor.h"
+#include "io/output.h"
+#include "io/journal.h"
+#include "io/batch.h"
+#include "io/json_serializer.h"
+#include "io/snapshot.h"
+#include "io/board_loader.h"
+#include "game/message_catalog.h"
+#include <stdio.h>
 #include <string.h>
 #include <stddef.h>
+#include <time.h>
 
 #ifndef TESTING
+// 回放命令日志并保存最终状态，不进入终端循环
+static int run_replay(const char* journal_file, const char* dump_file, JsonStyle style) {
+    static GameContext ctx;
+    ReplayStats stats;
+
+    output_select(OUTPUT_BACKEND_NULL);
+    clock_t start = clock();
+    ReplayResult result = replay_journal(&ctx, journal_file, &stats);
+    double seconds = (double)(clock() - start) / CLOCKS_PER_SEC;
+    if (result == REPLAY_BOARD_MISMATCH) {
+        printf("日志记录的地图（%s，%d 格）与当前地图（%s，%d 格）不同，请用 -m 指定记录时的地图\n",
+               stats.board_name, stats.board_size, ctx.board->name, ctx.board->size);
+        return 1;
+    }
+    if (result != REPLAY_OK) {
+        printf("无法回放日志文件: %s\n", journal_file);
+        return 1;
+    }
+    if (save_game_dump_with_style(&ctx, dump_file, style) != 0) {
+        fprintf(stderr, "无法写入存档文件: %s\n", dump_file);
+        return 1;
+    }
+
+    printf("回放完成: %llu 条命令, %llu 次交互应答, 用时 %.3f 秒\n",
+           (unsigned long long)stats.commands, (unsigned long long)stats.prompts, seconds);
+    if (stats.rng_mismatches || stats.prompt_mismatches) {
+        printf("警告: 回放与记录不一致（随机数 %llu 次, 交互应答 %llu 次）\n",
+               (unsigned long long)stats.rng_mismatches, (unsigned long long)stats.prompt_mismatches);
+    }
+    if (stats.truncated) {
+        printf("警告: 日志末尾记录不完整，已忽略\n");
+    }
+    printf("最终状态已保存到 %s\n", dump_file);
+    return 0;
+}
+
+// 批处理：从脚本读取命令和交互应答，不绘制界面；dump_file 不为 NULL 时保存最终状态
+static int run_batch(const char* script_file, const char* preset_file, const char* dump_file,
+                     JsonStyle style) {
+    static GameContext ctx;
+    BatchStats stats;
+
+    output_select(OUTPUT_BACKEND_NULL);
+    // 与终端游戏相同的种子，结果与标准输入驱动逐字节一致
+    game_context_init(&ctx, 12345, 0);
+    ctx.io.dump.style = style;
+    switch (run_batch_script(&ctx, script_file, preset_file, &stats)) {
+        case BATCH_OK:
+            break;
+        case BATCH_SCRIPT_ERROR:
+            fprintf(stderr, "无法读取脚本文件: %s\n", script_file);
+            return 1;
+        case BATCH_PRESET_ERROR:
+            fprintf(stderr, "预设文件格式错误: %s 第 %d 行第 %d 列: %s\n",
+                    preset_file ? preset_file : "preset.json", stats.preset_error.line,
+                    stats.preset_error.column, stats.preset_error.message);
+            return 1;
+        case BATCH_NO_PLAYERS:
+            fprintf(stderr, "没有选择任何角色: %s\n", script_file);
+            return 1;
+        case BATCH_DUMP_ERROR:
+            // 对局已经走完，最终状态照常保存
+            fprintf(stderr, "脚本中有 %llu 次 dump 保存失败，第一次为: %s\n",
+                    (unsigned long long)stats.dump_failures, stats.failed_dump);
+            break;
+    }
+
+    if (dump_file && save_game_dump_with_style(&ctx, dump_file, style) != 0) {
+        fprintf(stderr, "无法写入存档文件: %s\n", dump_file);
+        return 1;
+    }
+    return stats.dump_failures > 0 ? 1 : 0;
+}
+
 int main(int argc, char* argv[]) {
-    const char* preset_file = NULL;
+    static Board board;
+    GameOptions options;
+    OutputBackendKind output_kind = OUTPUT_BACKEND_AUTO;
+    const char* replay_file = NULL;
+    const char* batch_file = NULL;
+    const char* dump_file = NULL;
+    game_options_default(&options);
+    board_init();
+    register_builtin_commands();
     
     // 解析命令行参数
     for (int i = 1; i < argc; i++) {
         if (strcmp(argv[i], "-i") == 0 && i + 1 < argc) {
-            preset_file = argv[i + 1];
+            options.preset_file = argv[i + 1];
             i++; // 跳过下一个参数
+        } else if (strcmp(argv[i], "--output") == 0 && i + 1 < argc) {
+            // 输出后端：auto（默认）、ansi、plain、null
+            if (!output_parse_backend(argv[i + 1], &output_kind)) {
+                printf("未知的输出方式: %s（可选 auto/ansi/plain/null）\n", argv[i + 1]);
+                return 1;
+            }
+            i++;
+        } else if (strcmp(argv[i], "--verbosity") == 0 && i + 1 < argc) {
+            // 消息详细程度：quiet、events、full（默认）
+            if (!parse_verbosity(argv[i + 1], &options.verbosity)) {
+                printf("未知的详细程度: %s（可选 quiet/events/full）\n", argv[i + 1]);
+                return 1;
+            }
+            i++;
+        } else if (strcmp(argv[i], "--journal") == 0 && i + 1 < argc) {
+            // 把本局的命令、交互应答和随机数位置记录到二进制日志
+            options.journal_file = argv[i + 1];
+            i++;
+        } else if (strcmp(argv[i], "--replay") == 0 && i + 1 < argc) {
+            // 回放二进制日志，结果写入 --dump 指定的文件（默认 dump.json）
+            replay_file = argv[i + 1];
+            i++;
+        } else if (strcmp(argv[i], "-b") == 0 && i + 1 < argc) {
+            // 批处理脚本：与标准输入相同的命令流，不绘制界面，结果写入 -o 指定的文件
+            batch_file = argv[i + 1];
+            i++;
+        } else if ((strcmp(argv[i], "-o") == 0 || strcmp(argv[i], "--dump") == 0) && i + 1 < argc) {
+            dump_file = argv[i + 1];
+            i++;
+        } else if (strcmp(argv[i], "--compact") == 0) {
+            // 存档写成不含空白的单行 JSON（dump 命令、--dump/-o 和 --convert 的输出），须放在 --convert 之前
+            options.dump_style = JSON_STYLE_COMPACT;
+        } else if (strcmp(argv[i], "-m") == 0 && i + 1 < argc) {
+            // 自定义地图，须放在其他会创建对局的参数（--convert 等）之前；回放时须与录制时相同，否则拒绝回放
+            char error[256];
+            if (board_load(&board, argv[i + 1], error, sizeof(error)) != 0) {
+                printf("无法加载地图文件 %s: %s\n", argv[i + 1], error);
+                return 1;
+            }
+            board_select(&board);
+            i++;
+        } else if (strcmp(argv[i], "--convert") == 0 && i + 2 < argc) {
+            // JSON 存档与二进制快照互转：--convert 输入 输出
+            if (convert_game_file(argv[i + 1], argv[i + 2], options.dump_style) != 0) {
+                printf("转换失败: %s\n", argv[i + 1]);
+                return 1;
+            }
+            printf("已转换 %s -> %s\n", argv[i + 1], argv[i + 2]);
+            return 0;
         }
     }
     
-    if (preset_file) {
-        run_game_with_preset(preset_file);
-    } else {
-        run_game();
+    if (replay_file) {
+        return run_replay(replay_file, dump_file ? dump_file : "dump.json", options.dump_style);
     }
+    if (batch_file) {
+        return run_batch(batch_file, options.preset_file, dump_file, options.dump_style);
+    }
+
+    output_init(output_kind);
+    run_game_with_options(&options);
     return 0;
 }
-#endif
\ No newline at end of file
+#endif
@@ -0,0 +1,266 @@
+#include "bot_policy.h"
+#include "bot_search.h"
+#include "../game/decision.h"
+#include "../game/land.h"
+#include "../game/block_system.h"
+#include "../game/prop_shop.h"
+#include "../game/ownership.h"
+#include "../game/tile_set.h"
+#include <string.h>
+
+#define DICE_MAX 6                  // 一次掷骰最多前进的步数
+#define CONSERVATIVE_RESERVE 3000   // 保守策略买地、升级后至少保留的现金
+#define CONSERVATIVE_SELL_BELOW 500 // 保守策略现金低于此值时出售房产
+#define RANDOM_SELL_ODDS 32         // 随机策略每回合有 1/RANDOM_SELL_ODDS 的概率出售一块房产
+#define SEAT_SEED_STEP 0x9E3779B97F4A7C15ULL // 相邻座位随机流种子的间隔
+
+// ---- 公用判断 ----
+
+static bool always_yes(const BotView* view, int location, int amount) {
+    (void)view;
+    (void)location;
+    (void)amount;
+    return true;
+}
+
+static int random_gift(const BotView* view) {
+    return (int)rng_below(view->rng, 3) + GIFT_BONUS;
+}
+
+static int skip_shop(const BotView* view) {
+    (void)view;
+    return PROP_CHOICE_EXIT;
+}
+
+// 下一次掷骰可能走到的格子上是否有路障
+static bool barrier_within_reach(const BotView* view) {
+    const GameContext* ctx = view->ctx;
+    if (!board_contains(ctx->board, view->self->location)) {
+        return false;
+    }
+    return tile_set_first_ahead(&ctx->state.placed_prop.barrier, ctx->board->size,
+                                view->self->location, DICE_MAX) > 0;
+}
+
+// 自己地块上的过路费，不是自己的地块返回 0
+static int own_toll(const BotView* view, int location) {
+    const House* house = &view->ctx->state.houses[location];
+    if (house->owner_id != view->self->index) {
+        return 0;
+    }
+    return house->price * (house->level + 1) / 2;
+}
+
+// ---- greedy：尽量扩张，用路障把对手拦在自己的房产上 ----
+
+static int greedy_gift(const BotView* view) {
+    (void)view;
+    return GIFT_BONUS;
+}
+
+static int greedy_prop(const BotView* view) {
+    if (view->self->credit >= PROP_BARRIER_PRICE) return 1;
+    if (view->self->credit >= PROP_ROBOT_PRICE) return 2;
+    return PROP_CHOICE_EXIT;
+}
+
+// 身后过路费最高的自家地块，后面的对手走过时会被拦下
+static int greedy_block(const BotView* view) {
+    const GameContext* ctx = view->ctx;
+    int best_distance = 0;
+    int best_toll = 0;
+    for (int distance = -BLOCK_RANGE; distance < 0; distance++) {
+        int location = calculate_block_position(ctx->board, view->self->location, distance);
+        if (!board_contains(ctx->board, location) ||
+            tile_set_has(&ctx->state.placed_prop.barrier, location)) {
+            continue;
+        }
+        int toll = own_toll(view, location);
+        if (toll > best_toll) {
+            best_toll = toll;
+            best_distance = distance;
+        }
+    }
+    return best_distance;
+}
+
+static bool greedy_robot(const BotView* view) {
+    return barrier_within_reach(view);
+}
+
+// ---- conservative：保留现金，现金不足时出售房产 ----
+
+static bool conservative_spend(const BotView* view, int location, int amount) {
+    (void)location;
+    return view->self->fund - amount >= CONSERVATIVE_RESERVE;
+}
+
+static int conservative_gift(const BotView* view) {
+    (void)view;
+    return GIFT_GOD;
+}
+
+static int conservative_prop(const BotView* view) {
+    if (view->self->prop.robot == 0 && view->self->credit >= PROP_ROBOT_PRICE) return 2;
+    return PROP_CHOICE_EXIT;
+}
+
+// 现金过低时出售投资最多的一块房产（售价为投资的两倍）
+static int conservative_sell(const BotView* view) {
+    if (view->self->fund >= CONSERVATIVE_SELL_BELOW) {
+        return -1;
+    }
+    const GameContext* ctx = view->ctx;
+    int best = -1;
+    int best_investment = 0;
+    for (int location = next_owned_house(ctx, view->self->index, -1); location >= 0;
+         location = next_owned_house(ctx, view->self->index, location)) {
+        const House* house = &ctx->state.houses[location];
+        int investment = house->price * (1 + house->level);
+        if (investment > best_investment) {
+            best_investment = investment;
+            best = location;
+        }
+    }
+    return best;
+}
+
+// ---- random：每个问题随机作答，作为对照组 ----
+
+static bool random_yes_no(const BotView* view, int location, int amount) {
+    (void)location;
+    (void)amount;
+    return rng_below(view->rng, 2) == 0;
+}
+
+static int random_prop(const BotView* view) {
+    int choice = (int)rng_below(view->rng, 3);
+    return choice == 0 ? PROP_CHOICE_EXIT : choice;
+}
+
+static int random_sell(const BotView* view) {
+    if (rng_below(view->rng, RANDOM_SELL_ODDS) != 0) {
+        return -1;
+    }
+    const Holdings* holdings = player_holdings(view->ctx, view->self->index);
+    int skip = (int)rng_below(view->rng, (uint32_t)holdings->count);
+    int location = next_owned_house(view->ctx, view->self->index, -1);
+    while (skip-- > 0) {
+        location = next_owned_house(view->ctx, view->self->index, location);
+    }
+    return location;
+}
+
+static int random_block(const BotView* view) {
+    if (rng_below(view->rng, 4) != 0) {
+        return 0;
+    }
+    int distance = (int)rng_below(view->rng, 2 * BLOCK_RANGE) - BLOCK_RANGE;
+    return distance >= 0 ? distance + 1 : distance;
+}
+
+static bool random_robot(const BotView* view) {
+    return rng_below(view->rng, 2) == 0;
+}
+
+static const BotPolicy s_policies[] = {
+    { "basic", always_yes, always_yes, random_gift, skip_shop, NULL, NULL, NULL, NULL },
+    { "greedy", always_yes, always_yes, greedy_gift, greedy_prop, NULL, greedy_block, greedy_robot, NULL },
+    { "conservative", conservative_spend, conservative_spend, conservative_gift, conservative_prop,
+      conservative_sell, NULL, greedy_robot, NULL },
+    { "random", random_yes_no, random_yes_no, random_gift, random_prop, random_sell, random_block, random_robot,
+      NULL },
+    // 使用默认搜索参数，命令行参数通过 search_policy_init 得到的实例生效
+    { "mcts", search_buy, search_upgrade, greedy_gift, greedy_prop, search_sell, search_block, greedy_robot, NULL },
+};
+
+const BotPolicy* bot_policy_find(const char* name) {
+    for (size_t i = 0; i < sizeof(s_policies) / sizeof(s_policies[0]); i++) {
+        if (strcmp(s_policies[i].name, name) == 0) {
+            return &s_policies[i];
+        }
+    }
+    return NULL;
+}
+
+const BotPolicy* bot_policy_default(void) {
+    return &s_policies[0];
+}
+
+// ---- 接入决策接口 ----
+
+void bot_seats_init(BotSeats* seats, const BotPolicy* const* policies, uint64_t seed, uint64_t stream) {
+    for (int i = 0; i < MAX_PLAYERS; i++) {
+        seats->policies[i] = policies ? policies[i] : NULL;
+        rng_init(&seats->rng[i], seed + SEAT_SEED_STEP * (uint64_t)(i + 1), stream);
+    }
+}
+
+static const BotPolicy* seat_policy(const GameContext* ctx, const Player* player) {
+    const BotSeats* seats = (const BotSeats*)ctx->decisions.user_data;
+    const BotPolicy* policy = seats->policies[player_slot(ctx, player)];
+    return policy ? policy : bot_policy_default();
+}
+
+static BotView make_view(GameContext* ctx, const Player* player) {
+    BotSeats* seats = (BotSeats*)ctx->decisions.user_data;
+    BotView view = { ctx, player, &seats->rng[player_slot(ctx, player)], seat_policy(ctx, player)->params };
+    return view;
+}
+
+static bool bot_buy_land(GameContext* ctx, const Player* player, int location, int price) {
+    BotView view = make_view(ctx, player);
+    return seat_policy(ctx, player)->buy(&view, location, price);
+}
+
+static bool bot_upgrade_land(GameContext* ctx, const Player* player, int location, int cost) {
+    BotView view = make_view(ctx, player);
+    return seat_policy(ctx, player)->upgrade(&view, location, cost);
+}
+
+static int bot_choose_gift(GameContext* ctx, const Player* player) {
+    BotView view = make_view(ctx, player);
+    return seat_policy(ctx, player)->gift(&view);
+}
+
+static int bot_choose_prop(GameContext* ctx, const Player* player) {
+    BotView view = make_view(ctx, player);
+    int choice = seat_policy(ctx, player)->prop(&view);
+    // 道具屋在买不起时会再次询问，这里直接按退出处理，避免策略反复选择同一件道具
+    if (choice != PROP_CHOICE_EXIT) {
+        int price = get_prop_price(choice);
+        if (price < 0 || player->credit < price) {
+            return PROP_CHOICE_EXIT;
+        }
+    }
+    return choice;
+}
+
+void bot_attach(GameContext* ctx, BotSeats* seats) {
+    ctx->decisions.buy_land = bot_buy_land;
+    ctx->decisions.upgrade_land = bot_upgrade_land;
+    ctx->decisions.choose_gift = bot_choose_gift;
+    ctx->decisions.choose_prop = bot_choose_prop;
+    ctx->decisions.user_data = seats;
+}
+
+void bot_take_turn(GameContext* ctx, Player* player) {
+    const BotPolicy* policy = seat_policy(ctx, player);
+    BotView view = make_view(ctx, player);
+
+    if (policy->sell && player_holdings(ctx, player->index)->count > 0) {
+        int location = policy->sell(&view);
+        if (location >= 0) {
+            handle_sell_command(ctx, location);
+        }
+    }
+    if (policy->block && player->prop.barrier > 0) {
+        int distance = policy->block(&view);
+        if (distance != 0) {
+            handle_block_command(ctx, player, distance);
+        }
+    }
+    if (policy->robot && player->prop.robot > 0 && policy->robot(&view)) {
+        handle_robot_command(ctx, player);
+    }
+}
@@ -0,0 +1,56 @@
+#ifndef BOT_POLICY_H
+#define BOT_POLICY_H
+
+#include "../game/game_types.h"
+#include "../game/game_context.h"
+
+// 机器人玩家策略：回答与人类玩家相同的问题（买地、升级、礼品、道具），
+// 并在每回合掷骰前决定是否出售房产、放置路障、使用机器娃娃
+// 策略只读取对局状态，所有改动都由游戏逻辑按策略的答案执行
+
+#define BOT_POLICY_LIST "basic/greedy/conservative/random/mcts"
+
+// 策略看到的对局：ctx 只读；rng 是本座位自己的随机流，需要随机性的策略从这里抽取，不影响掷骰
+typedef struct {
+    const GameContext* ctx;
+    const Player* self;
+    Rng* rng;
+    const void* params; // 本座位策略实例的参数，NULL 表示使用默认参数
+} BotView;
+
+typedef struct {
+    const char* name;
+    bool (*buy)(const BotView* view, int location, int price);
+    bool (*upgrade)(const BotView* view, int location, int cost);
+    int (*gift)(const BotView* view);  // GiftChoice
+    int (*prop)(const BotView* view);  // 道具编号或 PROP_CHOICE_EXIT，买不起时按退出处理
+    // 回合开始时的主动操作，NULL 表示从不执行；只在玩家有相应房产或道具时询问
+    int (*sell)(const BotView* view);  // 出售的房产位置，-1 不出售
+    int (*block)(const BotView* view); // 放置路障的相对距离 (-BLOCK_RANGE..BLOCK_RANGE)，0 不放置
+    bool (*robot)(const BotView* view); // 是否使用机器娃娃
+    const void* params; // 策略参数，同一组回调配上不同参数即为不同的策略实例；内置策略为 NULL
+} BotPolicy;
+
+// 按名称查找内置策略，未知名称返回 NULL
+const BotPolicy* bot_policy_find(const char* name);
+
+// 默认策略：买地、升级一律接受，礼品随机，不进道具屋，不主动操作
+const BotPolicy* bot_policy_default(void);
+
+// 各座位的策略和随机流
+typedef struct {
+    const BotPolicy* policies[MAX_PLAYERS]; // NULL 项使用默认策略
+    Rng rng[MAX_PLAYERS];
+} BotSeats;
+
+// 按座位号设置策略（policies 为 NULL 时全部使用默认策略），
+// 第 i 个座位的随机流由 seed 和座位号导出，流编号为 stream，与掷骰用的随机流互不相关
+void bot_seats_init(BotSeats* seats, const BotPolicy* const* policies, uint64_t seed, uint64_t stream);
+
+// 本局的决策改由各座位的策略回答；seats 须在对局期间保持有效
+void bot_attach(GameContext* ctx, BotSeats* seats);
+
+// 执行当前玩家掷骰前的主动操作，须先调用 bot_attach
+void bot_take_turn(GameContext* ctx, Player* player);
+
+#endif // BOT_POLICY_H
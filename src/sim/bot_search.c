@@ -0,0 +1,504 @@
+#define _POSIX_C_SOURCE 200112L
+
+#include "bot_search.h"
+#include "simulator.h"
+#include "mc_runner.h"
+#include "../game/fork_pool.h"
+#include "../game/land.h"
+#include "../game/block_system.h"
+#include "../game/ownership.h"
+#include "../game/tile_set.h"
+#include <math.h>
+#include <pthread.h>
+#include <stdlib.h>
+#include <time.h>
+
+#define SEARCH_MAX_CANDIDATES 8 // 每次决策最多比较的候选答案数
+#define SEARCH_UCB_C 0.5        // UCB1 探索系数（估值在 0..1 之间）
+
+#define SEARCH_DEFAULT_BUDGET_MS 5.0
+#define SEARCH_DEFAULT_PLAYOUTS 512
+#define SEARCH_DEFAULT_HORIZON 40
+
+static const SearchConfig s_default_config = {
+    SEARCH_DEFAULT_BUDGET_MS, SEARCH_DEFAULT_PLAYOUTS, SEARCH_DEFAULT_HORIZON, 1, NULL
+};
+
+typedef enum {
+    SEARCH_BUY,
+    SEARCH_UPGRADE,
+    SEARCH_SELL,
+    SEARCH_BLOCK
+} SearchAction;
+
+// 一次决策：从 root 局面比较 candidates 中的各个答案
+typedef struct {
+    const GameContext* root;
+    const BotView* view;                    // 做决策时策略看到的对局
+    const SearchConfig* config;
+    int slot;                               // 做决策的玩家
+    SearchAction action;
+    int location;                           // 买地、升级的地块
+    int amount;                             // 买地、升级的费用
+    int candidates[SEARCH_MAX_CANDIDATES];
+    int candidate_count;
+    const BotPolicy* seats[MAX_PLAYERS];    // 模拟中各座位的策略
+    int threads;                            // 参与本次搜索的线程数
+    double deadline;                        // 截止时刻，0 表示不限时
+} SearchProblem;
+
+typedef struct SearchPool SearchPool;
+
+// 单个线程的搜索统计，按缓存行对齐避免伪共享
+typedef struct {
+    const SearchProblem* problem;           // 本轮的决策，不参与本轮时为 NULL
+    SearchPool* pool;
+    GameContext* child;
+    BotSeats seats;                         // 子对局各座位的策略和随机流
+    int id;
+    int playout_limit;
+    int visits[SEARCH_MAX_CANDIDATES];
+    double total[SEARCH_MAX_CANDIDATES];
+} __attribute__((aligned(64))) SearchWorker;
+
+// 每个调用线程一套搜索资源：子对局槽位和常驻的辅助线程，0 号工作者由调用线程自己运行
+// 首次搜索时创建，此后每次决策只唤醒辅助线程；需要更多线程时重建，search_thread_exit 时释放
+struct SearchPool {
+    ForkPool forks;
+    SearchWorker* workers;                  // capacity 个
+    pthread_t helpers[MC_MAX_THREADS];      // 第 i 个辅助线程运行 i 号工作者
+    int capacity;                           // 工作者数（含调用线程）
+    int helper_count;                       // 成功启动的辅助线程数
+    pthread_mutex_t lock;
+    pthread_cond_t start;                   // 新一轮搜索开始，或要求退出
+    pthread_cond_t done;                    // 本轮的辅助线程全部完成
+    unsigned round;                         // 已开始的搜索轮次
+    int pending;                            // 本轮尚未完成的辅助线程数
+    bool stopping;
+};
+
+static __thread SearchPool* t_search;
+
+static double now_seconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+void search_default_config(SearchConfig* config) {
+    *config = s_default_config;
+}
+
+bool search_config_valid(const SearchConfig* config) {
+    return config->budget_ms >= 0 && config->max_playouts >= 0 && config->horizon > 0 &&
+           config->threads >= 1 && config->threads <= MC_MAX_THREADS &&
+           (config->budget_ms > 0 || config->max_playouts > 0);
+}
+
+void search_policy_init(BotPolicy* policy, const SearchConfig* config) {
+    *policy = *bot_policy_find("mcts");
+    policy->params = config;
+}
+
+// ---- 模拟 ----
+
+// 对子对局执行候选答案；出售和放置路障发生在掷骰之前，执行后把这一回合走完
+static void apply_candidate(GameContext* child, const SearchProblem* problem, int answer) {
+    Player* player = &child->state.players[problem->slot];
+    switch (problem->action) {
+        case SEARCH_BUY:
+            if (answer) {
+                player->fund -= problem->amount;
+                house_set_owner(child, problem->location, player->index);
+            }
+            child->state.game.interaction_pending = false;
+            break;
+        case SEARCH_UPGRADE:
+            if (answer) {
+                player->fund -= problem->amount;
+                house_set_level(child, problem->location, child->state.houses[problem->location].level + 1);
+            }
+            child->state.game.interaction_pending = false;
+            break;
+        case SEARCH_SELL:
+            if (answer >= 0) {
+                handle_sell_command(child, answer);
+            }
+            sim_finish_turn(child, player);
+            break;
+        case SEARCH_BLOCK:
+            if (answer != 0) {
+                handle_block_command(child, player, answer);
+            }
+            sim_finish_turn(child, player);
+            break;
+    }
+}
+
+// 模拟结束时对做决策玩家的估值：获胜为 1，破产为 0，否则为净资产在存活玩家中的占比
+static double evaluate(const GameContext* ctx, int slot) {
+    const Player* player = &ctx->state.players[slot];
+    if (!player->alive) {
+        return 0.0;
+    }
+    if (ctx->state.game.ended) {
+        return ctx->state.game.winner_id == slot ? 1.0 : 0.0;
+    }
+    double total = 0;
+    for (int i = 0; i < ctx->state.player_count; i++) {
+        if (ctx->state.players[i].alive) {
+            total += player_net_worth(ctx, &ctx->state.players[i]);
+        }
+    }
+    return total > 0 ? player_net_worth(ctx, player) / total : 0.0;
+}
+
+// 第 stream 局模拟：各候选答案的同一序号使用同一随机流，比较的是同样掷骰下的差别
+// 每回合开始前检查时限，到时中止并返回 -1
+static double playout(GameContext* child, BotSeats* seats, const SearchProblem* problem, int candidate,
+                      uint64_t stream) {
+    game_clone(child, problem->root);
+    bot_seats_init(seats, problem->seats, problem->root->rng.state, stream);
+    bot_attach(child, seats);
+    rng_init(&child->rng, problem->root->rng.state, stream);
+
+    apply_candidate(child, problem, problem->candidates[candidate]);
+    int horizon = problem->config->horizon;
+    int steps_left = horizon * (child->state.player_count + 1); // 含跳过破产玩家的步数
+    for (int turns = 0; turns < horizon && steps_left-- > 0 && !child->state.game.ended; ) {
+        if (problem->deadline > 0 && now_seconds() >= problem->deadline) {
+            return -1;
+        }
+        if (sim_play_turn(child)) {
+            turns++;
+        }
+    }
+    check_win_condition(child);
+    return evaluate(child, problem->slot);
+}
+
+static int select_candidate(const SearchWorker* worker, int played) {
+    int best = 0;
+    double best_score = -1;
+    for (int c = 0; c < worker->problem->candidate_count; c++) {
+        if (worker->visits[c] == 0) {
+            return c;
+        }
+        double mean = worker->total[c] / worker->visits[c];
+        double score = mean + SEARCH_UCB_C * sqrt(log((double)played) / worker->visits[c]);
+        if (score > best_score) {
+            best_score = score;
+            best = c;
+        }
+    }
+    return best;
+}
+
+static void run_playouts(SearchWorker* worker) {
+    const SearchProblem* problem = worker->problem;
+    for (int played = 0; worker->playout_limit == 0 || played < worker->playout_limit; played++) {
+        // 模拟内每回合也会检查，这里覆盖候选答案本身就结束了对局、没有后续回合的情况
+        if (problem->deadline > 0 && now_seconds() >= problem->deadline) {
+            break;
+        }
+        int c = select_candidate(worker, played);
+        uint64_t stream = (uint64_t)worker->visits[c] * problem->threads + worker->id;
+        double value = playout(worker->child, &worker->seats, problem, c, stream);
+        if (value < 0) {
+            break; // 到达时限，中止的这局不计入
+        }
+        worker->total[c] += value;
+        worker->visits[c]++;
+    }
+}
+
+// 辅助线程：等待新一轮搜索，参与时运行自己的工作者，完成后通知调用线程
+static void* search_helper_main(void* arg) {
+    SearchWorker* worker = (SearchWorker*)arg;
+    SearchPool* pool = worker->pool;
+    unsigned seen = 0;
+
+    pthread_mutex_lock(&pool->lock);
+    for (;;) {
+        while (!pool->stopping && pool->round == seen) {
+            pthread_cond_wait(&pool->start, &pool->lock);
+        }
+        if (pool->stopping) {
+            break;
+        }
+        seen = pool->round;
+        if (!worker->problem) {
+            continue;
+        }
+        pthread_mutex_unlock(&pool->lock);
+        run_playouts(worker);
+        pthread_mutex_lock(&pool->lock);
+        if (--pool->pending == 0) {
+            pthread_cond_signal(&pool->done);
+        }
+    }
+    pthread_mutex_unlock(&pool->lock);
+    return NULL;
+}
+
+static void search_pool_destroy(SearchPool* pool) {
+    pthread_mutex_lock(&pool->lock);
+    pool->stopping = true;
+    pthread_cond_broadcast(&pool->start);
+    pthread_mutex_unlock(&pool->lock);
+    for (int i = 1; i <= pool->helper_count; i++) {
+        pthread_join(pool->helpers[i], NULL);
+    }
+    pthread_cond_destroy(&pool->done);
+    pthread_cond_destroy(&pool->start);
+    pthread_mutex_destroy(&pool->lock);
+    fork_pool_destroy(&pool->forks);
+    free(pool->workers);
+    free(pool);
+}
+
+// 创建 capacity 个工作者的搜索资源；辅助线程启动失败时由已启动的线程承担，失败返回 NULL
+static SearchPool* search_pool_create(int capacity) {
+    SearchPool* pool = (SearchPool*)calloc(1, sizeof(SearchPool));
+    if (!pool) {
+        return NULL;
+    }
+    if (posix_memalign((void**)&pool->workers, 64, sizeof(SearchWorker) * capacity) != 0) {
+        pool->workers = NULL;
+    }
+    if (!pool->workers || fork_pool_init(&pool->forks, capacity) != 0) {
+        free(pool->workers);
+        free(pool);
+        return NULL;
+    }
+    pool->capacity = capacity;
+    pthread_mutex_init(&pool->lock, NULL);
+    pthread_cond_init(&pool->start, NULL);
+    pthread_cond_init(&pool->done, NULL);
+    for (int i = 0; i < capacity; i++) {
+        pool->workers[i].problem = NULL;
+        pool->workers[i].pool = pool;
+        pool->workers[i].id = i;
+    }
+    for (int i = 1; i < capacity; i++) {
+        if (pthread_create(&pool->helpers[i], NULL, search_helper_main, &pool->workers[i]) != 0) {
+            break;
+        }
+        pool->helper_count++;
+    }
+    return pool;
+}
+
+void search_thread_exit(void) {
+    if (t_search) {
+        search_pool_destroy(t_search);
+        t_search = NULL;
+    }
+}
+
+// 搜索给不出答案时改用 rollout 策略回答
+static int rollout_answer(const SearchProblem* problem) {
+    const BotPolicy* rollout = problem->config->rollout ? problem->config->rollout : bot_policy_default();
+    BotView view = *problem->view;
+    view.params = rollout->params;
+    switch (problem->action) {
+        case SEARCH_BUY:
+            return rollout->buy(&view, problem->location, problem->amount);
+        case SEARCH_UPGRADE:
+            return rollout->upgrade(&view, problem->location, problem->amount);
+        case SEARCH_SELL:
+            return rollout->sell ? rollout->sell(&view) : -1;
+        case SEARCH_BLOCK:
+            return rollout->block ? rollout->block(&view) : 0;
+    }
+    return problem->candidates[0];
+}
+
+// 运行搜索，返回平均估值最高的候选答案（相同时取靠前的）
+static int run_search(SearchProblem* problem) {
+    const SearchConfig* config = problem->config;
+    if (problem->candidate_count == 1) {
+        return problem->candidates[0];
+    }
+
+    if (!t_search || t_search->capacity < config->threads) {
+        search_thread_exit();
+        t_search = search_pool_create(config->threads);
+        if (!t_search) {
+            return rollout_answer(problem);
+        }
+    }
+    SearchPool* pool = t_search;
+    int threads = config->threads <= pool->helper_count + 1 ? config->threads : pool->helper_count + 1;
+    problem->threads = threads;
+
+    // 模拟中自己换成 rollout 策略，避免在子对局里再次搜索
+    const BotSeats* parent_seats = (const BotSeats*)problem->root->decisions.user_data;
+    for (int i = 0; i < MAX_PLAYERS; i++) {
+        const BotPolicy* policy = parent_seats ? parent_seats->policies[i] : NULL;
+        if (i == problem->slot || (policy && policy->buy == search_buy)) {
+            policy = config->rollout;
+        }
+        problem->seats[i] = policy ? policy : bot_policy_default();
+    }
+    problem->deadline = config->budget_ms > 0 ? now_seconds() + config->budget_ms / 1000.0 : 0;
+
+    for (int i = 0; i < pool->capacity; i++) {
+        SearchWorker* worker = &pool->workers[i];
+        if (i >= threads) {
+            worker->problem = NULL;
+            continue;
+        }
+        worker->problem = problem;
+        worker->child = fork_pool_acquire(&pool->forks, problem->root);
+        worker->playout_limit = config->max_playouts > 0 ? (config->max_playouts + threads - 1) / threads : 0;
+        for (int c = 0; c < SEARCH_MAX_CANDIDATES; c++) {
+            worker->visits[c] = 0;
+            worker->total[c] = 0;
+        }
+    }
+
+    // 唤醒辅助线程，调用线程自己运行 0 号工作者，再等其余工作者完成
+    if (threads > 1) {
+        pthread_mutex_lock(&pool->lock);
+        pool->pending = threads - 1;
+        pool->round++;
+        pthread_cond_broadcast(&pool->start);
+        pthread_mutex_unlock(&pool->lock);
+    }
+    run_playouts(&pool->workers[0]);
+    if (threads > 1) {
+        pthread_mutex_lock(&pool->lock);
+        while (pool->pending > 0) {
+            pthread_cond_wait(&pool->done, &pool->lock);
+        }
+        pthread_mutex_unlock(&pool->lock);
+    }
+
+    int best = -1;
+    double best_mean = -1;
+    bool complete = true;
+    for (int c = 0; c < problem->candidate_count; c++) {
+        int visits = 0;
+        double total = 0;
+        for (int i = 0; i < threads; i++) {
+            visits += pool->workers[i].visits[c];
+            total += pool->workers[i].total[c];
+        }
+        if (visits == 0) {
+            complete = false;
+        } else if (total / visits > best_mean) {
+            best_mean = total / visits;
+            best = c;
+        }
+    }
+    for (int i = 0; i < threads; i++) {
+        fork_pool_release(&pool->forks, pool->workers[i].child);
+    }
+    // 有候选一局也没模拟完时无从比较
+    return complete ? problem->candidates[best] : rollout_answer(problem);
+}
+
+// ---- 候选答案 ----
+
+static void init_problem(SearchProblem* problem, const BotView* view, SearchAction action) {
+    problem->root = view->ctx;
+    problem->view = view;
+    problem->config = view->params ? (const SearchConfig*)view->params : &s_default_config;
+    problem->slot = player_slot(view->ctx, view->self);
+    problem->action = action;
+    problem->location = -1;
+    problem->amount = 0;
+    problem->candidate_count = 0;
+}
+
+// 按 weight 从大到小保留至多 SEARCH_MAX_CANDIDATES 个候选，第 0 个候选固定不动
+static void add_candidate(SearchProblem* problem, int weights[], int answer, int weight) {
+    int n = problem->candidate_count;
+    if (n == SEARCH_MAX_CANDIDATES) {
+        if (weight <= weights[n - 1]) {
+            return;
+        }
+        n--;
+    }
+    while (n > 1 && weights[n - 1] < weight) {
+        problem->candidates[n] = problem->candidates[n - 1];
+        weights[n] = weights[n - 1];
+        n--;
+    }
+    problem->candidates[n] = answer;
+    weights[n] = weight;
+    if (problem->candidate_count < SEARCH_MAX_CANDIDATES) {
+        problem->candidate_count++;
+    }
+}
+
+static bool search_yes_no(const BotView* view, SearchAction action, int location, int amount) {
+    SearchProblem problem;
+    init_problem(&problem, view, action);
+    problem.location = location;
+    problem.amount = amount;
+    problem.candidates[0] = 1;
+    problem.candidates[1] = 0;
+    problem.candidate_count = 2;
+    return run_search(&problem) != 0;
+}
+
+bool search_buy(const BotView* view, int location, int price) {
+    return search_yes_no(view, SEARCH_BUY, location, price);
+}
+
+bool search_upgrade(const BotView* view, int location, int cost) {
+    return search_yes_no(view, SEARCH_UPGRADE, location, cost);
+}
+
+// 现金不足以支付对手地块上的最高过路费时才考虑出售，候选为投资最多的几块房产
+int search_sell(const BotView* view) {
+    const GameContext* ctx = view->ctx;
+    int max_toll = 0;
+    for (int i = 0; i < ctx->board->size; i++) {
+        const House* house = &ctx->state.houses[i];
+        if (house->owner_id >= 0 && house->owner_id != view->self->index) {
+            int toll = house->price * (house->level + 1) / 2;
+            if (toll > max_toll) max_toll = toll;
+        }
+    }
+    if (view->self->fund >= max_toll) {
+        return -1;
+    }
+
+    SearchProblem problem;
+    int weights[SEARCH_MAX_CANDIDATES];
+    init_problem(&problem, view, SEARCH_SELL);
+    add_candidate(&problem, weights, -1, 0);
+    for (int location = next_owned_house(ctx, view->self->index, -1); location >= 0;
+         location = next_owned_house(ctx, view->self->index, location)) {
+        const House* house = &ctx->state.houses[location];
+        add_candidate(&problem, weights, location, house->price * (1 + house->level));
+    }
+    return run_search(&problem);
+}
+
+// 候选为放置范围内过路费最高的几块自家地块
+int search_block(const BotView* view) {
+    const GameContext* ctx = view->ctx;
+    SearchProblem problem;
+    int weights[SEARCH_MAX_CANDIDATES];
+    init_problem(&problem, view, SEARCH_BLOCK);
+    add_candidate(&problem, weights, 0, 0);
+    for (int distance = -BLOCK_RANGE; distance <= BLOCK_RANGE; distance++) {
+        if (distance == 0) {
+            continue;
+        }
+        int location = calculate_block_position(ctx->board, view->self->location, distance);
+        if (!board_contains(ctx->board, location) ||
+            tile_set_has(&ctx->state.placed_prop.barrier, location)) {
+            continue;
+        }
+        const House* house = &ctx->state.houses[location];
+        if (house->owner_id == view->self->index) {
+            add_candidate(&problem, weights, distance, house->price * (house->level + 1));
+        }
+    }
+    return run_search(&problem);
+}
@@ -0,0 +1,38 @@
+#ifndef BOT_SEARCH_H
+#define BOT_SEARCH_H
+
+#include "bot_policy.h"
+
+// 搜索型机器人（mcts 策略）：在买地、升级、出售和放置路障时，
+// 从当前局面为每个候选答案分叉出子对局，用后续掷骰的随机模拟估计胜率，选择估值最高的答案
+// 候选答案之间按 UCB1 分配模拟次数；多线程时各线程独立搜索后合并统计（根节点并行）
+// 搜索参数随策略实例（BotPolicy.params）传递，内置的 mcts 策略使用默认参数
+
+typedef struct {
+    double budget_ms;         // 每次决策的时限（毫秒），0 表示不限时
+    int max_playouts;         // 每次决策的模拟局数上限，0 表示不限（此时必须设置时限）
+    int horizon;              // 每局模拟向前推演的回合数
+    int threads;              // 并行模拟的线程数（含调用线程）
+    const BotPolicy* rollout; // 模拟中自己使用的策略，其他座位沿用各自的策略
+} SearchConfig;
+
+void search_default_config(SearchConfig* config);
+
+// 检查参数是否有效
+bool search_config_valid(const SearchConfig* config);
+
+// 以 config 为搜索参数的 mcts 策略实例；config 须在策略使用期间保持有效
+// 只按模拟局数限制时结果可复现，设置了时限时模拟次数取决于机器速度；
+// 时限内未能让每个候选答案都完成一局模拟时，改用 rollout 策略的答案
+void search_policy_init(BotPolicy* policy, const SearchConfig* config);
+
+// 停止调用线程的搜索辅助线程并释放子对局槽位，进行过搜索的线程结束前调用
+void search_thread_exit(void);
+
+// BotPolicy 回调
+bool search_buy(const BotView* view, int location, int price);
+bool search_upgrade(const BotView* view, int location, int cost);
+int search_sell(const BotView* view);
+int search_block(const BotView* view);
+
+#endif // BOT_SEARCH_H
@@ -0,0 +1,138 @@
+#define _POSIX_C_SOURCE 200112L
+
+#include "mc_runner.h"
+#include "bot_search.h"
+#include "../game/character.h"
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+// 每个工作线程自有的种子区间，按缓存行对齐避免伪共享
+typedef struct {
+    long long next; // 下一个未领取的对局序号，所有线程都通过原子加领取
+    long long end;  // 区间末尾（不含）
+} __attribute__((aligned(64))) SeedRange;
+
+// 工作线程私有数据，统计结果只在线程结束后合并
+typedef struct {
+    int id;
+    int thread_count;
+    const SimConfig* config;
+    SeedRange* ranges;
+    SimStats stats;
+} __attribute__((aligned(64))) McWorker;
+
+static double now_seconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+int mc_default_thread_count(void) {
+    long cores = sysconf(_SC_NPROCESSORS_ONLN);
+    if (cores < 1) return 1;
+    if (cores > MC_MAX_THREADS) return MC_MAX_THREADS;
+    return (int)cores;
+}
+
+// 从指定区间领取一批对局，返回领取数量，区间耗尽时返回 0
+static long long claim_chunk(SeedRange* range, long long* first) {
+    if (__atomic_load_n(&range->next, __ATOMIC_RELAXED) >= range->end) {
+        return 0;
+    }
+    long long start = __atomic_fetch_add(&range->next, MC_CHUNK_GAMES, __ATOMIC_RELAXED);
+    if (start >= range->end) {
+        return 0;
+    }
+    *first = start;
+    return (start + MC_CHUNK_GAMES <= range->end) ? MC_CHUNK_GAMES : range->end - start;
+}
+
+static void* mc_worker_main(void* arg) {
+    McWorker* worker = (McWorker*)arg;
+    GameContext* ctx = (GameContext*)malloc(sizeof(GameContext));
+    if (!ctx) {
+        return NULL;
+    }
+
+    // 先处理自己的区间，耗尽后依次从其他线程的区间窃取
+    for (int k = 0; k < worker->thread_count; k++) {
+        SeedRange* range = &worker->ranges[(worker->id + k) % worker->thread_count];
+        long long first;
+        long long count;
+        while ((count = claim_chunk(range, &first)) > 0) {
+            for (long long i = first; i < first + count; i++) {
+                simulate_game(ctx, worker->config, (uint64_t)i, &worker->stats);
+            }
+        }
+    }
+
+    free(ctx);
+    search_thread_exit();
+    return NULL;
+}
+
+// 多线程蒙特卡洛模拟：种子按线程均分，空闲线程窃取其他线程剩余的对局
+int run_monte_carlo(SimConfig* config, SimStats* stats) {
+    if (config->threads <= 0) {
+        config->threads = mc_default_thread_count();
+    }
+    if (config->threads > MC_MAX_THREADS) {
+        config->threads = MC_MAX_THREADS;
+    }
+    int thread_count = config->threads;
+
+    SeedRange* ranges = NULL;
+    McWorker* workers = NULL;
+    pthread_t* threads = (pthread_t*)malloc(sizeof(pthread_t) * thread_count);
+    if (posix_memalign((void**)&ranges, 64, sizeof(SeedRange) * thread_count) != 0) ranges = NULL;
+    if (posix_memalign((void**)&workers, 64, sizeof(McWorker) * thread_count) != 0) workers = NULL;
+    if (!ranges || !workers || !threads) {
+        free(ranges);
+        free(workers);
+        free(threads);
+        return -1;
+    }
+
+    // 角色表只读共享，必须在启动线程前初始化（地图已在程序启动时构建）
+    init_characters();
+
+    for (int i = 0; i < thread_count; i++) {
+        ranges[i].next = config->games * i / thread_count;
+        ranges[i].end = config->games * (i + 1) / thread_count;
+        workers[i].id = i;
+        workers[i].thread_count = thread_count;
+        workers[i].config = config;
+        workers[i].ranges = ranges;
+        sim_stats_init(&workers[i].stats);
+    }
+
+    double start = now_seconds();
+    int started = 0;
+    for (; started < thread_count; started++) {
+        if (pthread_create(&threads[started], NULL, mc_worker_main, &workers[started]) != 0) {
+            break;
+        }
+    }
+    // 线程创建失败时由已启动的线程窃取剩余区间
+    if (started == 0) {
+        mc_worker_main(&workers[0]);
+    }
+    for (int i = 0; i < started; i++) {
+        pthread_join(threads[i], NULL);
+    }
+
+    sim_stats_init(stats);
+    for (int i = 0; i < thread_count; i++) {
+        sim_stats_merge(stats, &workers[i].stats);
+    }
+    stats->elapsed_seconds = now_seconds() - start;
+
+    free(ranges);
+    free(workers);
+    free(threads);
+    return 0;
+}
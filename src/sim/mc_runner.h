@@ -0,0 +1,12 @@
+#ifndef MC_RUNNER_H
+#define MC_RUNNER_H
+
+#include "simulator.h"
+
+#define MC_MAX_THREADS 256 // 工作线程数上限
+#define MC_CHUNK_GAMES 64  // 每次领取的对局数
+
+int mc_default_thread_count(void);
+int run_monte_carlo(SimConfig* config, SimStats* stats);
+
+#endif // MC_RUNNER_H
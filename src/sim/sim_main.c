@@ -0,0 +1,132 @@
+#include "simulator.h"
+#include "mc_runner.h"
+#include "../io/output.h"
+#include "../io/board_loader.h"
+#include "bot_search.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+static void print_usage(const char* program) {
+    printf("用法: %s [-g 局数] [-n 玩家数] [-f 初始资金] [-t 最大回合数] [-s 随机种子]\n", program);
+    printf("          [-j 线程数，0 为全部核心] [-p 地段1地价,地段2地价,地段3地价] [-m 地图文件]\n");
+    printf("          [-b 座位0策略,座位1策略,...]  策略: %s，未列出的座位使用 basic\n", BOT_POLICY_LIST);
+    printf("          mcts 搜索参数: [-L 每次决策时限(毫秒)，0 为不限] [-P 每次决策模拟局数上限，0 为不限]\n");
+    printf("                         [-H 模拟推演回合数] [-T 搜索线程数] [-R 模拟中自己使用的策略]\n");
+}
+
+// 解析形如 200,500,300 的地段地价列表
+static bool parse_district_prices(const char* text, int prices[]) {
+    int values[DISTRICT_COUNT];
+    if (sscanf(text, "%d,%d,%d", &values[0], &values[1], &values[2]) != DISTRICT_COUNT) {
+        return false;
+    }
+    for (int i = 0; i < DISTRICT_COUNT; i++) {
+        if (values[i] <= 0) return false;
+        prices[i + 1] = values[i];
+    }
+    return true;
+}
+
+// 解析形如 greedy,random 的座位策略列表
+static bool parse_policies(const char* text, const BotPolicy* policies[]) {
+    char buffer[256];
+    snprintf(buffer, sizeof(buffer), "%s", text);
+    int seat = 0;
+    for (char* name = strtok(buffer, ","); name; name = strtok(NULL, ",")) {
+        if (seat >= MAX_PLAYERS) return false;
+        policies[seat] = bot_policy_find(name);
+        if (!policies[seat]) return false;
+        seat++;
+    }
+    return seat > 0;
+}
+
+#ifndef TESTING
+int main(int argc, char* argv[]) {
+    static Board board;
+    SimConfig config;
+    SearchConfig search;
+    board_init();
+    sim_default_config(&config);
+    search_default_config(&search);
+
+    // 解析命令行参数
+    for (int i = 1; i < argc; i++) {
+        if (i + 1 < argc && strcmp(argv[i], "-g") == 0) {
+            config.games = atoll(argv[++i]);
+        } else if (i + 1 < argc && strcmp(argv[i], "-n") == 0) {
+            config.player_count = atoi(argv[++i]);
+        } else if (i + 1 < argc && strcmp(argv[i], "-f") == 0) {
+            config.initial_fund = atoi(argv[++i]);
+        } else if (i + 1 < argc && strcmp(argv[i], "-t") == 0) {
+            config.max_turns = atoi(argv[++i]);
+        } else if (i + 1 < argc && strcmp(argv[i], "-s") == 0) {
+            config.seed = strtoull(argv[++i], NULL, 10);
+        } else if (i + 1 < argc && strcmp(argv[i], "-j") == 0) {
+            config.threads = atoi(argv[++i]);
+        } else if (i + 1 < argc && strcmp(argv[i], "-p") == 0) {
+            if (!parse_district_prices(argv[++i], config.district_prices)) {
+                print_usage(argv[0]);
+                return 1;
+            }
+        } else if (i + 1 < argc && strcmp(argv[i], "-b") == 0) {
+            if (!parse_policies(argv[++i], config.policies)) {
+                print_usage(argv[0]);
+                return 1;
+            }
+        } else if (i + 1 < argc && strcmp(argv[i], "-L") == 0) {
+            search.budget_ms = atof(argv[++i]);
+        } else if (i + 1 < argc && strcmp(argv[i], "-P") == 0) {
+            search.max_playouts = atoi(argv[++i]);
+        } else if (i + 1 < argc && strcmp(argv[i], "-H") == 0) {
+            search.horizon = atoi(argv[++i]);
+        } else if (i + 1 < argc && strcmp(argv[i], "-T") == 0) {
+            search.threads = atoi(argv[++i]);
+        } else if (i + 1 < argc && strcmp(argv[i], "-R") == 0) {
+            search.rollout = bot_policy_find(argv[++i]);
+            if (!search.rollout || search.rollout->buy == search_buy) {
+                print_usage(argv[0]);
+                return 1;
+            }
+        } else if (i + 1 < argc && strcmp(argv[i], "-m") == 0) {
+            char error[256];
+            if (board_load(&board, argv[++i], error, sizeof(error)) != 0) {
+                printf("错误: 无法加载地图 %s: %s\n", argv[i], error);
+                return 1;
+            }
+            board_select(&board);
+        } else {
+            print_usage(argv[0]);
+            return 1;
+        }
+    }
+
+    if (config.player_count < 2 || config.player_count > MAX_PLAYERS ||
+        config.games <= 0 || config.max_turns <= 0 || config.threads < 0 ||
+        !search_config_valid(&search)) {
+        print_usage(argv[0]);
+        return 1;
+    }
+
+    // mcts 座位改用带命令行搜索参数的策略实例
+    BotPolicy mcts;
+    search_policy_init(&mcts, &search);
+    for (int i = 0; i < MAX_PLAYERS; i++) {
+        if (config.policies[i] && config.policies[i]->buy == search_buy) {
+            config.policies[i] = &mcts;
+        }
+    }
+
+    // 模拟过程中不输出任何游戏内容，也不使用颜色；须在启动工作线程前选定
+    output_select(OUTPUT_BACKEND_NULL);
+
+    SimStats stats;
+    if (run_monte_carlo(&config, &stats) != 0) {
+        printf("错误: 无法启动模拟线程\n");
+        return 1;
+    }
+    print_sim_report(&config, &stats);
+    return 0;
+}
+#endif
@@ -0,0 +1,186 @@
+#include "simulator.h"
+#include "../game/game_state.h"
+#include "../game/player.h"
+#include "../game/character.h"
+#include "../game/land.h"
+#include "../game/ownership.h"
+#include "../io/command_processor.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+
+void sim_default_config(SimConfig* config) {
+    memset(config, 0, sizeof(*config));
+    config->games = 1000;
+    config->player_count = 4;
+    config->initial_fund = 10000;
+    config->max_turns = 5000;
+    config->seed = 12345;
+    config->threads = 0;
+}
+
+void sim_stats_init(SimStats* stats) {
+    memset(stats, 0, sizeof(*stats));
+    stats->min_turns = INT_MAX;
+    stats->max_turns = 0;
+}
+
+void sim_stats_merge(SimStats* dst, const SimStats* src) {
+    dst->games += src->games;
+    dst->turns += src->turns;
+    dst->unfinished += src->unfinished;
+    for (int i = 0; i < MAX_PLAYERS; i++) {
+        dst->wins[i] += src->wins[i];
+    }
+    for (int i = 0; i <= DISTRICT_COUNT; i++) {
+        dst->bankruptcies[i] += src->bankruptcies[i];
+    }
+    for (int i = 0; i < SIM_LENGTH_BUCKETS; i++) {
+        dst->length_histogram[i] += src->length_histogram[i];
+    }
+    if (src->min_turns < dst->min_turns) dst->min_turns = src->min_turns;
+    if (src->max_turns > dst->max_turns) dst->max_turns = src->max_turns;
+}
+
+// 按配置覆盖各地段地价，用于比较不同定价方案
+static void apply_district_prices(GameContext* ctx, const SimConfig* config) {
+    for (int i = 0; i < ctx->board->size; i++) {
+        int district = board_district(ctx->board, i);
+        if (district > 0 && config->district_prices[district] > 0) {
+            ctx->state.houses[i].price = config->district_prices[district];
+        }
+    }
+    ownership_rebuild(ctx);
+}
+
+Player* sim_play_turn(GameContext* ctx) {
+    check_win_condition(ctx);
+    if (ctx->state.game.ended) {
+        return NULL;
+    }
+
+    Player* current_player = &ctx->state.players[ctx->state.game.now_player_id];
+    if (!current_player->alive) {
+        switch_to_next_player(ctx, false);
+        return NULL;
+    }
+
+    // 掷骰前的主动操作，之后掷骰移动并立即结算落地事件，不经过终端主循环
+    bot_take_turn(ctx, current_player);
+    sim_finish_turn(ctx, current_player);
+    return current_player;
+}
+
+void sim_finish_turn(GameContext* ctx, Player* player) {
+    handle_roll_command(ctx);
+    on_player_land(ctx, player);
+    ctx->state.game.interaction_pending = false;
+}
+
+// 模拟第 game_index 局游戏，返回本局回合数
+int simulate_game(GameContext* ctx, const SimConfig* config, uint64_t game_index, SimStats* stats) {
+    // 无头模式：跳过所有交互提示和渲染
+    // 所有对局共用同一种子，以对局序号作为独立的随机流
+    BotSeats seats;
+    game_context_init(ctx, config->seed, game_index);
+    bot_seats_init(&seats, config->policies, config->seed, game_index);
+    bot_attach(ctx, &seats);
+    ctx->io.echo_prompts = false;
+    ctx->events.verbosity = VERBOSITY_QUIET; // 无头模拟不记录事件，也就不会生成任何文本
+    apply_district_prices(ctx, config);
+
+    for (int i = 0; i < config->player_count; i++) {
+        create_player_by_character(ctx, i + 1, config->initial_fund);
+    }
+    ctx->state.game.started = true;
+
+    int turns = 0;
+    while (turns < config->max_turns) {
+        Player* current_player = sim_play_turn(ctx);
+        if (!current_player) {
+            if (ctx->state.game.ended) {
+                break;
+            }
+            continue;
+        }
+        turns++;
+
+        // 破产只会发生在支付过路费时，按落点所在地段记录原因
+        if (!current_player->alive) {
+            stats->bankruptcies[board_district(ctx->board, current_player->location)]++;
+        }
+    }
+
+    stats->games++;
+    stats->turns += turns;
+    if (ctx->state.game.ended && ctx->state.game.winner_id != -1) {
+        stats->wins[ctx->state.game.winner_id]++;
+    } else if (!ctx->state.game.ended) {
+        stats->unfinished++;
+    }
+
+    int bucket = turns / SIM_LENGTH_BUCKET;
+    if (bucket >= SIM_LENGTH_BUCKETS) bucket = SIM_LENGTH_BUCKETS - 1;
+    stats->length_histogram[bucket]++;
+    if (turns < stats->min_turns) stats->min_turns = turns;
+    if (turns > stats->max_turns) stats->max_turns = turns;
+    return turns;
+}
+
+// 是否有座位指定了策略，都用默认策略时报告保持原样
+static bool sim_has_policies(const SimConfig* config) {
+    for (int i = 0; i < config->player_count; i++) {
+        if (config->policies[i]) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void print_sim_report(const SimConfig* config, const SimStats* stats) {
+    const Board* board = board_active();
+    double elapsed = stats->elapsed_seconds > 0 ? stats->elapsed_seconds : 1e-9;
+    double games = stats->games > 0 ? (double)stats->games : 1.0;
+
+    printf("=== 无头模拟结果 ===\n");
+    printf("模拟局数: %lld (玩家数 %d, 初始资金 %d, 种子 %llu, 线程 %d)\n",
+           stats->games, config->player_count, config->initial_fund, (unsigned long long)config->seed, config->threads);
+    if (board != board_classic()) {
+        printf("地图: %s (%d 格)\n", board->name, board->size);
+    }
+    printf("地段地价: 地段1 %d, 地段2 %d, 地段3 %d\n",
+           config->district_prices[1] > 0 ? config->district_prices[1] : get_district_price(board, 1),
+           config->district_prices[2] > 0 ? config->district_prices[2] : get_district_price(board, 2),
+           config->district_prices[3] > 0 ? config->district_prices[3] : get_district_price(board, 3));
+    printf("总回合数: %lld, 平均每局 %.1f 回合 (最短 %d, 最长 %d)\n",
+           stats->turns, stats->turns / games,
+           stats->games > 0 ? stats->min_turns : 0, stats->max_turns);
+    printf("未分胜负: %lld 局 (超过 %d 回合)\n", stats->unfinished, config->max_turns);
+    if (sim_has_policies(config)) {
+        printf("座位策略:");
+        for (int i = 0; i < config->player_count; i++) {
+            const BotPolicy* policy = config->policies[i] ? config->policies[i] : bot_policy_default();
+            printf(" %s", policy->name);
+        }
+        printf("\n");
+    }
+    for (int i = 0; i < config->player_count; i++) {
+        printf("玩家%d 获胜: %lld 局 (%.1f%%)\n", i, stats->wins[i], 100.0 * stats->wins[i] / games);
+    }
+    for (int i = 1; i <= DISTRICT_COUNT; i++) {
+        printf("地段%d 过路费破产: %lld 次\n", i, stats->bankruptcies[i]);
+    }
+    printf("对局长度分布 (每档 %d 回合):\n", SIM_LENGTH_BUCKET);
+    for (int i = 0; i < SIM_LENGTH_BUCKETS; i++) {
+        if (stats->length_histogram[i] == 0) continue;
+        if (i == SIM_LENGTH_BUCKETS - 1) {
+            printf("  >=%5d: %lld\n", i * SIM_LENGTH_BUCKET, stats->length_histogram[i]);
+        } else {
+            printf("  %5d-%5d: %lld\n", i * SIM_LENGTH_BUCKET, (i + 1) * SIM_LENGTH_BUCKET - 1,
+                   stats->length_histogram[i]);
+        }
+    }
+    printf("耗时: %.3f 秒, %.0f 局/秒, %.0f 回合/秒\n",
+           stats->elapsed_seconds, stats->games / elapsed, stats->turns / elapsed);
+}
@@ -0,0 +1,49 @@
+#ifndef SIMULATOR_H
+#define SIMULATOR_H
+
+#include "../game/game_types.h"
+#include "../game/game_context.h"
+#include "bot_policy.h"
+
+#define SIM_LENGTH_BUCKET 100  // 对局长度直方图每档的回合数
+#define SIM_LENGTH_BUCKETS 50  // 直方图档数，最后一档收容所有更长的对局
+
+// 无头模拟配置
+typedef struct {
+    long long games;    // 模拟局数
+    int player_count;   // 每局玩家数 (2-MAX_PLAYERS)，超过 4 位时使用机器人角色
+    int initial_fund;   // 初始资金
+    int max_turns;      // 单局最大回合数，超过视为未分胜负
+    uint64_t seed;      // 随机种子，第 i 局使用该种子下的第 i 个随机流
+    int threads;        // 工作线程数，0 表示使用全部 CPU 核心
+    int district_prices[DISTRICT_COUNT + 1]; // 各地段地价，0 表示使用默认地价
+    const BotPolicy* policies[MAX_PLAYERS];  // 各座位的策略，NULL 表示使用默认策略
+} SimConfig;
+
+// 模拟统计结果
+typedef struct {
+    long long games;             // 已完成模拟的局数
+    long long turns;             // 总回合数（每次掷骰计一回合）
+    long long unfinished;        // 达到回合上限仍未结束的局数
+    long long wins[MAX_PLAYERS]; // 各座位获胜次数
+    long long bankruptcies[DISTRICT_COUNT + 1];     // 按致命过路费所在地段统计的破产次数
+    long long length_histogram[SIM_LENGTH_BUCKETS]; // 对局长度分布
+    int min_turns;               // 最短对局回合数
+    int max_turns;               // 最长对局回合数
+    double elapsed_seconds;      // 总耗时
+} SimStats;
+
+void sim_default_config(SimConfig* config);
+void sim_stats_init(SimStats* stats);
+void sim_stats_merge(SimStats* dst, const SimStats* src);
+// 推进一步：检查胜负，跳过破产玩家或让当前玩家走完一回合（须先调用 bot_attach）
+// 返回走完回合的玩家；游戏已结束或跳过了破产玩家时返回 NULL
+Player* sim_play_turn(GameContext* ctx);
+
+// 当前玩家掷骰、移动并结算落地事件，即一回合中主动操作之后的部分
+void sim_finish_turn(GameContext* ctx, Player* player);
+
+int simulate_game(GameContext* ctx, const SimConfig* config, uint64_t game_index, SimStats* stats);
+void print_sim_report(const SimConfig* config, const SimStats* stats);
+
+#endif // SIMULATOR_H
@@ -0,0 +1,415 @@
+#include "json_reader.h"
+#include <stdlib.h>
+#include <string.h>
+
+// 嵌套层数上限，防止畸形输入耗尽栈空间
+#define JSON_MAX_DEPTH 64
+
+typedef struct {
+    const char* pos;
+    const char* line_start;  // 当前行首，用于计算列号
+    int line;
+    int depth;
+    JsonDocument* doc;
+    const char* error_message;
+    const char* error_pos;
+} JsonParser;
+
+static int fail(JsonParser* p, const char* at, const char* message) {
+    if (!p->error_message) {
+        p->error_message = message;
+        p->error_pos = at;
+    }
+    return -1;
+}
+
+static int new_node(JsonParser* p, JsonType type, const char* key, int key_len) {
+    JsonDocument* doc = p->doc;
+    if (doc->count == doc->capacity) {
+        int capacity = doc->capacity ? doc->capacity * 2 : 64;
+        JsonNode* nodes = (JsonNode*)realloc(doc->nodes, (size_t)capacity * sizeof(JsonNode));
+        if (!nodes) {
+            return fail(p, p->pos, "内存不足");
+        }
+        doc->nodes = nodes;
+        doc->capacity = capacity;
+    }
+    JsonNode* node = &doc->nodes[doc->count];
+    node->type = type;
+    node->key = key;
+    node->key_len = key_len;
+    node->text = p->pos;
+    node->len = 0;
+    node->first_child = -1;
+    node->next_sibling = -1;
+    return doc->count++;
+}
+
+static void skip_whitespace(JsonParser* p) {
+    for (;;) {
+        char c = *p->pos;
+        if (c == '\n') {
+            p->pos++;
+            p->line++;
+            p->line_start = p->pos;
+        } else if (c == ' ' || c == '\t' || c == '\r') {
+            p->pos++;
+        } else {
+            return;
+        }
+    }
+}
+
+static bool is_hex(char c) {
+    return (c >= '0' && c <= '9') || (c >= 'a' && c <= 'f') || (c >= 'A' && c <= 'F');
+}
+
+static bool is_digit(char c) {
+    return c >= '0' && c <= '9';
+}
+
+// 扫描字符串（p->pos 指向开头的引号），返回内容起点和长度
+static bool scan_string(JsonParser* p, const char** start, int* len) {
+    const char* s = p->pos + 1;
+    *start = s;
+    for (;;) {
+        unsigned char c = (unsigned char)*s;
+        if (c == '"') {
+            break;
+        }
+        if (c == '\0') {
+            fail(p, s, "字符串缺少结束引号");
+            return false;
+        }
+        if (c < 0x20) {
+            fail(p, s, "字符串中含有控制字符");
+            return false;
+        }
+        if (c == '\\') {
+            char e = s[1];
+            if (e == 'u') {
+                if (!is_hex(s[2]) || !is_hex(s[3]) || !is_hex(s[4]) || !is_hex(s[5])) {
+                    fail(p, s, "无效的 \\u 转义");
+                    return false;
+                }
+                s += 6;
+                continue;
+            }
+            if (e == '\0' || !strchr("\"\\/bfnrt", e)) {
+                fail(p, s, "无效的转义字符");
+                return false;
+            }
+            s += 2;
+            continue;
+        }
+        s++;
+    }
+    *len = (int)(s - *start);
+    p->pos = s + 1;
+    return true;
+}
+
+static bool scan_number(JsonParser* p) {
+    const char* s = p->pos;
+    if (*s == '-') s++;
+    if (*s == '0') {
+        s++;
+    } else if (is_digit(*s)) {
+        while (is_digit(*s)) s++;
+    } else {
+        fail(p, p->pos, "无效的数字");
+        return false;
+    }
+    if (*s == '.') {
+        s++;
+        if (!is_digit(*s)) {
+            fail(p, s, "小数点后缺少数字");
+            return false;
+        }
+        while (is_digit(*s)) s++;
+    }
+    if (*s == 'e' || *s == 'E') {
+        s++;
+        if (*s == '+' || *s == '-') s++;
+        if (!is_digit(*s)) {
+            fail(p, s, "指数缺少数字");
+            return false;
+        }
+        while (is_digit(*s)) s++;
+    }
+    p->pos = s;
+    return true;
+}
+
+static int parse_value(JsonParser* p, const char* key, int key_len);
+
+static int parse_container(JsonParser* p, const char* key, int key_len, bool is_object) {
+    if (++p->depth > JSON_MAX_DEPTH) {
+        return fail(p, p->pos, "嵌套层数过多");
+    }
+    int index = new_node(p, is_object ? JSON_OBJECT : JSON_ARRAY, key, key_len);
+    if (index < 0) {
+        return -1;
+    }
+    const char close = is_object ? '}' : ']';
+    p->pos++;
+    skip_whitespace(p);
+
+    int prev = -1;
+    if (*p->pos == close) {
+        p->pos++;
+    } else {
+        for (;;) {
+            const char* member_key = NULL;
+            int member_key_len = 0;
+            if (is_object) {
+                if (*p->pos != '"') {
+                    return fail(p, p->pos, "此处应为带引号的键");
+                }
+                if (!scan_string(p, &member_key, &member_key_len)) {
+                    return -1;
+                }
+                skip_whitespace(p);
+                if (*p->pos != ':') {
+                    return fail(p, p->pos, "键后缺少冒号");
+                }
+                p->pos++;
+                skip_whitespace(p);
+            }
+
+            int child = parse_value(p, member_key, member_key_len);
+            if (child < 0) {
+                return -1;
+            }
+            if (prev < 0) {
+                p->doc->nodes[index].first_child = child;
+            } else {
+                p->doc->nodes[prev].next_sibling = child;
+            }
+            prev = child;
+
+            skip_whitespace(p);
+            if (*p->pos == ',') {
+                p->pos++;
+                skip_whitespace(p);
+                continue;
+            }
+            if (*p->pos == close) {
+                p->pos++;
+                break;
+            }
+            return fail(p, p->pos, is_object ? "此处应为 ',' 或 '}'" : "此处应为 ',' 或 ']'");
+        }
+    }
+
+    JsonNode* node = &p->doc->nodes[index];
+    node->len = (int)(p->pos - node->text);
+    p->depth--;
+    return index;
+}
+
+static int parse_literal(JsonParser* p, const char* key, int key_len,
+                         JsonType type, const char* word) {
+    size_t len = strlen(word);
+    if (strncmp(p->pos, word, len) != 0) {
+        return fail(p, p->pos, "无法识别的值");
+    }
+    int index = new_node(p, type, key, key_len);
+    if (index < 0) {
+        return -1;
+    }
+    p->doc->nodes[index].len = (int)len;
+    p->pos += len;
+    return index;
+}
+
+static int parse_value(JsonParser* p, const char* key, int key_len) {
+    char c = *p->pos;
+    if (c == '{' || c == '[') {
+        return parse_container(p, key, key_len, c == '{');
+    }
+    if (c == '"') {
+        const char* start;
+        int len;
+        if (!scan_string(p, &start, &len)) {
+            return -1;
+        }
+        int index = new_node(p, JSON_STRING, key, key_len);
+        if (index >= 0) {
+            p->doc->nodes[index].text = start;
+            p->doc->nodes[index].len = len;
+        }
+        return index;
+    }
+    if (c == '-' || is_digit(c)) {
+        const char* start = p->pos;
+        if (!scan_number(p)) {
+            return -1;
+        }
+        int index = new_node(p, JSON_NUMBER, key, key_len);
+        if (index >= 0) {
+            p->doc->nodes[index].text = start;
+            p->doc->nodes[index].len = (int)(p->pos - start);
+        }
+        return index;
+    }
+    if (c == 't') return parse_literal(p, key, key_len, JSON_BOOL, "true");
+    if (c == 'f') return parse_literal(p, key, key_len, JSON_BOOL, "false");
+    if (c == 'n') return parse_literal(p, key, key_len, JSON_NULL, "null");
+    if (c == '\0') return fail(p, p->pos, "内容意外结束");
+    return fail(p, p->pos, "无法识别的值");
+}
+
+bool json_parse(JsonDocument* doc, const char* text, JsonError* error) {
+    doc->nodes = NULL;
+    doc->count = 0;
+    doc->capacity = 0;
+
+    JsonParser p;
+    p.pos = text;
+    p.line_start = text;
+    p.line = 1;
+    p.depth = 0;
+    p.doc = doc;
+    p.error_message = NULL;
+    p.error_pos = NULL;
+
+    // 跳过 UTF-8 BOM
+    if ((unsigned char)p.pos[0] == 0xEF && (unsigned char)p.pos[1] == 0xBB &&
+        (unsigned char)p.pos[2] == 0xBF) {
+        p.pos += 3;
+        p.line_start = p.pos;
+    }
+
+    skip_whitespace(&p);
+    if (parse_value(&p, NULL, 0) >= 0) {
+        skip_whitespace(&p);
+        if (*p.pos != '\0') {
+            fail(&p, p.pos, "JSON 值之后有多余内容");
+        }
+    }
+
+    if (p.error_message) {
+        if (error) {
+            error->line = p.line;
+            error->column = (int)(p.error_pos - p.line_start) + 1;
+            error->message = p.error_message;
+        }
+        json_free(doc);
+        return false;
+    }
+    return true;
+}
+
+void json_free(JsonDocument* doc) {
+    free(doc->nodes);
+    doc->nodes = NULL;
+    doc->count = 0;
+    doc->capacity = 0;
+}
+
+bool json_key_equals(const JsonNode* node, const char* key) {
+    return node->key && strncmp(node->key, key, (size_t)node->key_len) == 0 &&
+           key[node->key_len] == '\0';
+}
+
+const JsonNode* json_first(const JsonDocument* doc, const JsonNode* container) {
+    if (!container || container->first_child < 0) {
+        return NULL;
+    }
+    return &doc->nodes[container->first_child];
+}
+
+const JsonNode* json_next(const JsonDocument* doc, const JsonNode* node) {
+    return node->next_sibling < 0 ? NULL : &doc->nodes[node->next_sibling];
+}
+
+const JsonNode* json_member(const JsonDocument* doc, const JsonNode* object, const char* key) {
+    if (!object || object->type != JSON_OBJECT) {
+        return NULL;
+    }
+    for (const JsonNode* child = json_first(doc, object); child; child = json_next(doc, child)) {
+        if (json_key_equals(child, key)) {
+            return child;
+        }
+    }
+    return NULL;
+}
+
+static int hex_value(char c) {
+    if (c >= '0' && c <= '9') return c - '0';
+    if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+    return c - 'A' + 10;
+}
+
+static unsigned read_hex4(const char* s) {
+    return (unsigned)(hex_value(s[0]) << 12 | hex_value(s[1]) << 8 | hex_value(s[2]) << 4 | hex_value(s[3]));
+}
+
+bool json_string_copy(const JsonNode* node, char* buffer, size_t size) {
+    if (!node || node->type != JSON_STRING || size == 0) {
+        return false;
+    }
+    const char* s = node->text;
+    const char* end = node->text + node->len;
+    size_t n = 0;
+    while (s < end && n + 1 < size) {
+        if (*s != '\\') {
+            buffer[n++] = *s++;
+            continue;
+        }
+        char e = s[1];
+        s += 2;
+        switch (e) {
+            case 'b': buffer[n++] = '\b'; break;
+            case 'f': buffer[n++] = '\f'; break;
+            case 'n': buffer[n++] = '\n'; break;
+            case 'r': buffer[n++] = '\r'; break;
+            case 't': buffer[n++] = '\t'; break;
+            case 'u': {
+                unsigned code = read_hex4(s);
+                s += 4;
+                // 代理对合成一个码点
+                if (code >= 0xD800 && code <= 0xDBFF && s + 6 <= end && s[0] == '\\' && s[1] == 'u') {
+                    unsigned low = read_hex4(s + 2);
+                    if (low >= 0xDC00 && low <= 0xDFFF) {
+                        code = 0x10000 + ((code - 0xD800) << 10) + (low - 0xDC00);
+                        s += 6;
+                    }
+                }
+                // 编码为 UTF-8，放不下时整体截断
+                unsigned char utf8[4];
+                size_t len;
+                if (code < 0x80) {
+                    utf8[0] = (unsigned char)code;
+                    len = 1;
+                } else if (code < 0x800) {
+                    utf8[0] = (unsigned char)(0xC0 | (code >> 6));
+                    utf8[1] = (unsigned char)(0x80 | (code & 0x3F));
+                    len = 2;
+                } else if (code < 0x10000) {
+                    utf8[0] = (unsigned char)(0xE0 | (code >> 12));
+                    utf8[1] = (unsigned char)(0x80 | ((code >> 6) & 0x3F));
+                    utf8[2] = (unsigned char)(0x80 | (code & 0x3F));
+                    len = 3;
+                } else {
+                    utf8[0] = (unsigned char)(0xF0 | (code >> 18));
+                    utf8[1] = (unsigned char)(0x80 | ((code >> 12) & 0x3F));
+                    utf8[2] = (unsigned char)(0x80 | ((code >> 6) & 0x3F));
+                    utf8[3] = (unsigned char)(0x80 | (code & 0x3F));
+                    len = 4;
+                }
+                if (n + len >= size) {
+                    s = end;
+                    break;
+                }
+                memcpy(buffer + n, utf8, len);
+                n += len;
+                break;
+            }
+            default: buffer[n++] = e; break;  // \" \\ \/
+        }
+    }
+    buffer[n] = '\0';
+    return true;
+}
@@ -0,0 +1,57 @@
+#ifndef JSON_READER_H
+#define JSON_READER_H
+
+#include <stdbool.h>
+#include <stddef.h>
+
+// 单遍 JSON 解析：一次扫描生成扁平节点数组（DOM），字符串和数字直接引用原文，不做复制
+// 节点之间用下标链接：容器的 first_child 指向第一个元素，元素之间用 next_sibling 串起
+
+typedef enum {
+    JSON_NULL,
+    JSON_BOOL,
+    JSON_NUMBER,
+    JSON_STRING,
+    JSON_ARRAY,
+    JSON_OBJECT
+} JsonType;
+
+typedef struct {
+    JsonType type;
+    const char* key;   // 对象成员的键（原文，不含引号），其余为 NULL
+    int key_len;
+    const char* text;  // 字符串内容（原文，不含引号）、数字或字面量的原文
+    int len;
+    int first_child;   // 容器的第一个元素，-1 表示没有
+    int next_sibling;  // 同一容器中的下一个元素，-1 表示没有
+} JsonNode;
+
+typedef struct {
+    int line;          // 出错位置，从 1 开始
+    int column;        // 按字节计，从 1 开始
+    const char* message;
+} JsonError;
+
+typedef struct {
+    JsonNode* nodes;   // nodes[0] 为根
+    int count;
+    int capacity;
+} JsonDocument;
+
+// 解析以 '\0' 结尾的文本；失败时填写 error（可为 NULL）并返回 false
+// 文本在文档使用期间必须保持有效
+bool json_parse(JsonDocument* doc, const char* text, JsonError* error);
+void json_free(JsonDocument* doc);
+
+// 对象中查找成员，找不到返回 NULL
+const JsonNode* json_member(const JsonDocument* doc, const JsonNode* object, const char* key);
+// 遍历容器：json_first(doc, node) 后反复 json_next(doc, child)，结束时返回 NULL
+const JsonNode* json_first(const JsonDocument* doc, const JsonNode* container);
+const JsonNode* json_next(const JsonDocument* doc, const JsonNode* node);
+
+// 键是否等于 key
+bool json_key_equals(const JsonNode* node, const char* key);
+// 把字符串节点反转义后复制到 buffer（截断到 size - 1），非字符串返回 false
+bool json_string_copy(const JsonNode* node, char* buffer, size_t size);
+
+#endif // JSON_READER_H
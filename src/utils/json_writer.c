@@ -0,0 +1,186 @@
+#include "json_writer.h"
+#include <string.h>
+
+static void put(JsonWriter* w, const char* text, size_t len) {
+    if (w->len < w->capacity) {
+        size_t room = w->capacity - w->len;
+        memcpy(w->data + w->len, text, len < room ? len : room);
+    }
+    w->len += len;
+}
+
+static void put_char(JsonWriter* w, char c) {
+    if (w->len < w->capacity) {
+        w->data[w->len] = c;
+    }
+    w->len++;
+}
+
+static void put_indent(JsonWriter* w, int depth) {
+    static const char spaces[] = "                                ";
+    size_t count = (size_t)depth * 4;
+    while (count > 0) {
+        size_t n = count < sizeof(spaces) - 1 ? count : sizeof(spaces) - 1;
+        put(w, spaces, n);
+        count -= n;
+    }
+}
+
+static void put_escaped(JsonWriter* w, const char* text) {
+    static const char hex[] = "0123456789abcdef";
+    put_char(w, '"');
+    const char* run = text;
+    for (const char* s = text; *s; s++) {
+        unsigned char c = (unsigned char)*s;
+        if (c >= 0x20 && c != '"' && c != '\\') {
+            continue;
+        }
+        put(w, run, (size_t)(s - run));
+        run = s + 1;
+        put_char(w, '\\');
+        switch (c) {
+            case '"': put_char(w, '"'); break;
+            case '\\': put_char(w, '\\'); break;
+            case '\n': put_char(w, 'n'); break;
+            case '\r': put_char(w, 'r'); break;
+            case '\t': put_char(w, 't'); break;
+            default: {
+                char u[5] = { 'u', '0', '0', hex[c >> 4], hex[c & 0xF] };
+                put(w, u, sizeof(u));
+                break;
+            }
+        }
+    }
+    put(w, run, strlen(run));
+    put_char(w, '"');
+}
+
+static void put_uint(JsonWriter* w, unsigned long long value) {
+    char digits[20];
+    int n = 0;
+    do {
+        digits[n++] = (char)('0' + value % 10);
+        value /= 10;
+    } while (value > 0);
+    char out[20];
+    for (int i = 0; i < n; i++) {
+        out[i] = digits[n - 1 - i];
+    }
+    put(w, out, (size_t)n);
+}
+
+// 写值之前的分隔符、换行缩进和键
+static void begin_value(JsonWriter* w, const char* key) {
+    if (w->depth > 0) {
+        bool in_line = w->inline_items[w->depth - 1];
+        if (!w->first) {
+            if (in_line && w->pretty) {
+                put(w, ", ", 2);
+            } else {
+                put_char(w, ',');
+            }
+        }
+        if (w->pretty && !in_line) {
+            put_char(w, '\n');
+            put_indent(w, w->depth);
+        }
+    }
+    w->first = false;
+    if (key) {
+        put_escaped(w, key);
+        if (w->pretty) {
+            put(w, ": ", 2);
+        } else {
+            put_char(w, ':');
+        }
+    }
+}
+
+static void begin_container(JsonWriter* w, const char* key, char open, bool inline_items) {
+    begin_value(w, key);
+    put_char(w, open);
+    if (w->depth < JSON_WRITER_MAX_DEPTH) {
+        w->inline_items[w->depth] = inline_items;
+    }
+    w->depth++;
+    w->first = true;
+}
+
+static void end_container(JsonWriter* w, char close) {
+    w->depth--;
+    bool in_line = w->depth < JSON_WRITER_MAX_DEPTH && w->inline_items[w->depth];
+    if (w->pretty && !in_line) {
+        // 与原有存档格式一致：空容器也占一个空行
+        if (w->first) {
+            put_char(w, '\n');
+        }
+        put_char(w, '\n');
+        put_indent(w, w->depth);
+    }
+    put_char(w, close);
+    w->first = false;
+}
+
+void json_writer_init(JsonWriter* w, char* buffer, size_t capacity, JsonStyle style) {
+    w->data = buffer;
+    w->capacity = capacity;
+    w->len = 0;
+    w->pretty = style == JSON_STYLE_PRETTY;
+    w->first = true;
+    w->depth = 0;
+}
+
+void json_writer_begin_object(JsonWriter* w, const char* key) {
+    begin_container(w, key, '{', false);
+}
+
+void json_writer_end_object(JsonWriter* w) {
+    end_container(w, '}');
+}
+
+void json_writer_begin_array(JsonWriter* w, const char* key, bool inline_items) {
+    begin_container(w, key, '[', inline_items);
+}
+
+void json_writer_end_array(JsonWriter* w) {
+    end_container(w, ']');
+}
+
+void json_writer_int(JsonWriter* w, const char* key, long long value) {
+    begin_value(w, key);
+    if (value < 0) {
+        put_char(w, '-');
+        put_uint(w, 0ULL - (unsigned long long)value);
+    } else {
+        put_uint(w, (unsigned long long)value);
+    }
+}
+
+void json_writer_uint(JsonWriter* w, const char* key, unsigned long long value) {
+    begin_value(w, key);
+    put_uint(w, value);
+}
+
+void json_writer_bool(JsonWriter* w, const char* key, bool value) {
+    begin_value(w, key);
+    if (value) {
+        put(w, "true", 4);
+    } else {
+        put(w, "false", 5);
+    }
+}
+
+void json_writer_string(JsonWriter* w, const char* key, const char* value) {
+    begin_value(w, key);
+    put_escaped(w, value);
+}
+
+size_t json_writer_finish(JsonWriter* w) {
+    if (w->pretty) {
+        put_char(w, '\n');
+    }
+    if (w->len < w->capacity) {
+        w->data[w->len] = '\0';
+    }
+    return w->len;
+}
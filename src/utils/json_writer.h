@@ -0,0 +1,42 @@
+#ifndef JSON_WRITER_H
+#define JSON_WRITER_H
+
+#include <stdbool.h>
+#include <stddef.h>
+
+// 流式 JSON 写入：直接写进调用方提供的缓冲区，不做任何分配
+// 缓冲区不够时继续计数但不再写入，结束后按 len 判断需要的大小（与 snprintf 相同）
+#define JSON_WRITER_MAX_DEPTH 16
+
+typedef enum {
+    JSON_STYLE_PRETTY,   // 每个成员一行，4 空格缩进（存档的默认格式）
+    JSON_STYLE_COMPACT   // 不含任何空白
+} JsonStyle;
+
+typedef struct {
+    char* data;
+    size_t capacity;
+    size_t len;                                 // 已生成的字节数（可能超过 capacity）
+    bool pretty;
+    bool first;                                 // 当前容器中还没有元素
+    int depth;
+    bool inline_items[JSON_WRITER_MAX_DEPTH];   // 该层数组的元素写在同一行
+} JsonWriter;
+
+void json_writer_init(JsonWriter* w, char* buffer, size_t capacity, JsonStyle style);
+
+// key 为 NULL 时写数组元素或顶层值
+void json_writer_begin_object(JsonWriter* w, const char* key);
+void json_writer_end_object(JsonWriter* w);
+void json_writer_begin_array(JsonWriter* w, const char* key, bool inline_items);
+void json_writer_end_array(JsonWriter* w);
+
+void json_writer_int(JsonWriter* w, const char* key, long long value);
+void json_writer_uint(JsonWriter* w, const char* key, unsigned long long value);
+void json_writer_bool(JsonWriter* w, const char* key, bool value);
+void json_writer_string(JsonWriter* w, const char* key, const char* value);
+
+// 结束输出并在放得下时补 '\0'，返回总长度（不含 '\0'）
+size_t json_writer_finish(JsonWriter* w);
+
+#endif // JSON_WRITER_H
@@ -0,0 +1,68 @@
+#include "rng.h"
+
+#define PCG_MULTIPLIER 6364136223846793005ULL
+
+// 推进一步 LCG 状态并输出 XSH-RR 变换结果
+static uint32_t pcg_step(Rng* rng) {
+    uint64_t old_state = rng->state;
+    rng->state = old_state * PCG_MULTIPLIER + rng->inc;
+    uint32_t xorshifted = (uint32_t)(((old_state >> 18u) ^ old_state) >> 27u);
+    uint32_t rot = (uint32_t)(old_state >> 59u);
+    return (xorshifted >> rot) | (xorshifted << ((-rot) & 31));
+}
+
+void rng_init(Rng* rng, uint64_t seed, uint64_t stream) {
+    rng->state = 0;
+    rng->inc = (stream << 1u) | 1u;
+    pcg_step(rng);
+    rng->state += seed;
+    pcg_step(rng);
+    rng->seed = seed;
+    rng->stream = stream;
+    rng->draws = 0;
+}
+
+// 由种子、流编号和已产生个数恢复发生器，用于存档后确定性续局
+void rng_restore(Rng* rng, uint64_t seed, uint64_t stream, uint64_t draws) {
+    rng_init(rng, seed, stream);
+    rng_advance(rng, draws);
+}
+
+// 跳过 delta 个随机数，O(log delta)
+void rng_advance(Rng* rng, uint64_t delta) {
+    uint64_t cur_mult = PCG_MULTIPLIER;
+    uint64_t cur_plus = rng->inc;
+    uint64_t acc_mult = 1;
+    uint64_t acc_plus = 0;
+    uint64_t remaining = delta;
+    while (remaining > 0) {
+        if (remaining & 1) {
+            acc_mult *= cur_mult;
+            acc_plus = acc_plus * cur_mult + cur_plus;
+        }
+        cur_plus = (cur_mult + 1) * cur_plus;
+        cur_mult *= cur_mult;
+        remaining >>= 1;
+    }
+    rng->state = acc_mult * rng->state + acc_plus;
+    rng->draws += delta;
+}
+
+uint32_t rng_next(Rng* rng) {
+    rng->draws++;
+    return pcg_step(rng);
+}
+
+// 返回 [0, bound) 内无偏的均匀随机数
+uint32_t rng_below(Rng* rng, uint32_t bound) {
+    if (bound <= 1) {
+        return 0;
+    }
+    uint32_t threshold = (-bound) % bound;
+    for (;;) {
+        uint32_t r = rng_next(rng);
+        if (r >= threshold) {
+            return r % bound;
+        }
+    }
+}
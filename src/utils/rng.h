@@ -0,0 +1,22 @@
+#ifndef RNG_H
+#define RNG_H
+
+#include <stdint.h>
+
+// 每局独立的 PCG32 随机数发生器
+// 同一种子下不同 stream 互相独立，可用 draws 快速跳转到任意位置
+typedef struct {
+    uint64_t state;  // 内部状态
+    uint64_t inc;    // 流选择器（奇数）
+    uint64_t seed;   // 初始种子
+    uint64_t stream; // 流编号
+    uint64_t draws;  // 已产生的随机数个数
+} Rng;
+
+void rng_init(Rng* rng, uint64_t seed, uint64_t stream);
+void rng_restore(Rng* rng, uint64_t seed, uint64_t stream, uint64_t draws);
+void rng_advance(Rng* rng, uint64_t delta);
+uint32_t rng_next(Rng* rng);
+uint32_t rng_below(Rng* rng, uint32_t bound);
+
+#endif // RNG_H
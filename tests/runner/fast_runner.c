@@ -0,0 +1,452 @@
+#define _POSIX_C_SOURCE 200112L
+
+// 进程内并行集成测试：每个用例在独立的游戏上下文中回放 input.txt，
+// dump 的内容留在内存里，直接与 expected_result.json 比较
+// 测试状态与 run_agile_tests.py 相同：只运行 active 和 wip，未列出的用例视为 pending
+// 带 args.txt 的用例需要以不同的命令行多次启动程序，只由 run_agile_tests.py 运行
+
+#include "json_compare.h"
+#include "../../src/game/character.h"
+#include "../../src/io/batch.h"
+#include "../../src/io/command_processor.h"
+#include "../../src/io/json_serializer.h"
+#include "../../src/io/output.h"
+#include <dirent.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <time.h>
+#include <unistd.h>
+
+#define RUNNER_MAX_THREADS 256
+#define RUNNER_PATH_SIZE 1024
+#define RUNNER_NAME_SIZE 128
+
+typedef enum {
+    TEST_ACTIVE,
+    TEST_WIP,
+    TEST_PENDING,
+    TEST_DISABLED,
+    TEST_UNKNOWN
+} TestStatus;
+
+typedef struct {
+    char name[RUNNER_NAME_SIZE];
+    TestStatus status;
+    bool passed;
+    char reason[256];
+} TestCase;
+
+typedef struct {
+    char name[RUNNER_NAME_SIZE];
+    TestStatus status;
+} StatusEntry;
+
+typedef struct {
+    const char* root;
+    TestCase* cases;
+    int* queue;        // 需要运行的用例下标
+    int queue_count;
+    int next;          // 下一个未领取的位置，通过原子加领取
+} RunnerShared;
+
+// 工作线程私有数据：游戏上下文和最近一次 dump 的内容
+typedef struct {
+    RunnerShared* shared;
+    GameContext* ctx;
+    GameContext* scratch;
+    char* dump;
+    size_t dump_capacity;
+    size_t dump_len;
+    bool dumped;
+} RunnerWorker;
+
+static double now_seconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static TestStatus parse_status(const char* text) {
+    if (strcmp(text, "active") == 0) return TEST_ACTIVE;
+    if (strcmp(text, "wip") == 0) return TEST_WIP;
+    if (strcmp(text, "pending") == 0) return TEST_PENDING;
+    if (strcmp(text, "disabled") == 0) return TEST_DISABLED;
+    return TEST_UNKNOWN;
+}
+
+static char* trim(char* text) {
+    while (*text == ' ' || *text == '\t') text++;
+    char* end = text + strlen(text);
+    while (end > text && (end[-1] == ' ' || end[-1] == '\t' || end[-1] == '\n' || end[-1] == '\r')) {
+        end--;
+    }
+    *end = '\0';
+    return text;
+}
+
+// 读取 tests/test_status.config：每行 "用例名: 状态  # 注释"
+static StatusEntry* load_statuses(const char* root, int* count) {
+    char path[RUNNER_PATH_SIZE];
+    snprintf(path, sizeof(path), "%s/tests/test_status.config", root);
+    *count = 0;
+    FILE* file = fopen(path, "r");
+    if (!file) {
+        return NULL;
+    }
+
+    int capacity = 256;
+    StatusEntry* entries = (StatusEntry*)malloc(sizeof(StatusEntry) * (size_t)capacity);
+    char line[512];
+    while (entries && fgets(line, sizeof(line), file)) {
+        char* text = trim(line);
+        char* colon = strchr(text, ':');
+        if (text[0] == '\0' || text[0] == '#' || !colon) {
+            continue;
+        }
+        *colon = '\0';
+        char* status = colon + 1;
+        char* comment = strchr(status, '#');
+        if (comment) {
+            *comment = '\0';
+        }
+        if (*count == capacity) {
+            capacity *= 2;
+            StatusEntry* grown = (StatusEntry*)realloc(entries, sizeof(StatusEntry) * (size_t)capacity);
+            if (!grown) {
+                break;
+            }
+            entries = grown;
+        }
+        snprintf(entries[*count].name, RUNNER_NAME_SIZE, "%s", trim(text));
+        entries[*count].status = parse_status(trim(status));
+        (*count)++;
+    }
+    fclose(file);
+    return entries;
+}
+
+static TestStatus status_of(const StatusEntry* entries, int count, const char* name) {
+    TestStatus status = TEST_PENDING;
+    // 与 Python 的 dict 相同，重复出现时以最后一行为准
+    for (int i = 0; i < count; i++) {
+        if (strcmp(entries[i].name, name) == 0) {
+            status = entries[i].status;
+        }
+    }
+    return status;
+}
+
+static int compare_case_names(const void* a, const void* b) {
+    return strcmp(((const TestCase*)a)->name, ((const TestCase*)b)->name);
+}
+
+// 列出 tests/integration 下所有 test_ 开头的目录，按名称排序
+static TestCase* list_cases(const char* root, int* count) {
+    char path[RUNNER_PATH_SIZE];
+    snprintf(path, sizeof(path), "%s/tests/integration", root);
+    *count = 0;
+    DIR* dir = opendir(path);
+    if (!dir) {
+        return NULL;
+    }
+
+    int capacity = 512;
+    TestCase* cases = (TestCase*)calloc((size_t)capacity, sizeof(TestCase));
+    struct dirent* entry;
+    while (cases && (entry = readdir(dir)) != NULL) {
+        if (strncmp(entry->d_name, "test_", 5) != 0 || strlen(entry->d_name) >= RUNNER_NAME_SIZE) {
+            continue;
+        }
+        char full[RUNNER_PATH_SIZE];
+        struct stat st;
+        snprintf(full, sizeof(full), "%s/tests/integration/%s", root, entry->d_name);
+        if (stat(full, &st) != 0 || !S_ISDIR(st.st_mode)) {
+            continue;
+        }
+        if (*count == capacity) {
+            capacity *= 2;
+            TestCase* grown = (TestCase*)realloc(cases, sizeof(TestCase) * (size_t)capacity);
+            if (!grown) {
+                break;
+            }
+            cases = grown;
+        }
+        memset(&cases[*count], 0, sizeof(TestCase));
+        snprintf(cases[*count].name, RUNNER_NAME_SIZE, "%s", entry->d_name);
+        (*count)++;
+    }
+    closedir(dir);
+    if (cases) {
+        qsort(cases, (size_t)*count, sizeof(TestCase), compare_case_names);
+    }
+    return cases;
+}
+
+// dump 命令的存档钩子：只保留 dump.json，其他文件名不落盘，各用例互不干扰
+// 与 run_agile_tests.py 一致，比较前把玩家持有的炸弹清零并重算道具总数
+static int capture_dump(const GameContext* ctx, const char* filename, void* user_data) {
+    RunnerWorker* worker = (RunnerWorker*)user_data;
+    if (strcmp(filename, "dump.json") != 0) {
+        return 0;
+    }
+
+    *worker->scratch = *ctx;
+    for (int i = 0; i < MAX_PLAYERS; i++) {
+        Player* player = &worker->scratch->state.players[i];
+        if (player->prop.bomb != 0) {
+            player->prop.bomb = 0;
+            player->prop.total = player->prop.barrier + player->prop.robot;
+        }
+    }
+
+    size_t len = save_game_to_buffer(worker->scratch, worker->dump, worker->dump_capacity, JSON_STYLE_PRETTY);
+    if (len >= worker->dump_capacity) {
+        char* grown = (char*)realloc(worker->dump, len + 1);
+        if (!grown) {
+            return -1;
+        }
+        worker->dump = grown;
+        worker->dump_capacity = len + 1;
+        save_game_to_buffer(worker->scratch, worker->dump, worker->dump_capacity, JSON_STYLE_PRETTY);
+    }
+    worker->dump_len = len;
+    worker->dumped = true;
+    return 0;
+}
+
+static bool file_exists(const char* path) {
+    return access(path, R_OK) == 0;
+}
+
+static void case_file(const RunnerWorker* worker, const TestCase* test, const char* file,
+                      char* path, size_t size) {
+    snprintf(path, size, "%s/tests/integration/%s/%s", worker->shared->root, test->name, file);
+}
+
+static void run_case(RunnerWorker* worker, TestCase* test) {
+    char input[RUNNER_PATH_SIZE];
+    char expected_file[RUNNER_PATH_SIZE];
+    char preset[RUNNER_PATH_SIZE];
+    case_file(worker, test, "input.txt", input, sizeof(input));
+    case_file(worker, test, "expected_result.json", expected_file, sizeof(expected_file));
+    // 终端在用例目录中运行时会尝试读取 preset.json，这里直接给出完整路径
+    case_file(worker, test, "preset.json", preset, sizeof(preset));
+
+    if (!file_exists(input) || !file_exists(expected_file)) {
+        snprintf(test->reason, sizeof(test->reason), "缺少文件: %s",
+                 file_exists(input) ? "expected_result.json" : "input.txt");
+        return;
+    }
+
+    game_context_init(worker->ctx, 12345, 0);
+    worker->ctx->io.dump.save = capture_dump;
+    worker->ctx->io.dump.user_data = worker;
+    worker->dumped = false;
+
+    BatchStats stats;
+    BatchResult result = run_batch_script(worker->ctx, input, preset, &stats);
+    if (result == BATCH_PRESET_ERROR) {
+        snprintf(test->reason, sizeof(test->reason), "预设文件格式错误: 第 %d 行第 %d 列: %s",
+                 stats.preset_error.line, stats.preset_error.column, stats.preset_error.message);
+        return;
+    }
+    if (!worker->dumped) {
+        snprintf(test->reason, sizeof(test->reason), "未生成dump.json文件");
+        return;
+    }
+
+    char* expected_text = read_text_file(expected_file, NULL);
+    JsonDocument expected;
+    JsonDocument actual;
+    JsonError error;
+    if (!expected_text || !json_parse(&expected, expected_text, &error)) {
+        snprintf(test->reason, sizeof(test->reason), "期望文件格式错误: 第 %d 行第 %d 列: %s",
+                 expected_text ? error.line : 0, expected_text ? error.column : 0,
+                 expected_text ? error.message : "无法读取");
+        free(expected_text);
+        return;
+    }
+    if (!json_parse(&actual, worker->dump, &error)) {
+        snprintf(test->reason, sizeof(test->reason), "dump 内容无法解析: %s", error.message);
+        json_free(&expected);
+        free(expected_text);
+        return;
+    }
+
+    test->passed = json_expected_match(&expected, &actual, test->reason, sizeof(test->reason));
+    json_free(&actual);
+    json_free(&expected);
+    free(expected_text);
+}
+
+static void* runner_worker_main(void* arg) {
+    RunnerWorker* worker = (RunnerWorker*)arg;
+    RunnerShared* shared = worker->shared;
+    int index;
+    while ((index = __atomic_fetch_add(&shared->next, 1, __ATOMIC_RELAXED)) < shared->queue_count) {
+        run_case(worker, &shared->cases[shared->queue[index]]);
+    }
+    return NULL;
+}
+
+static int default_thread_count(void) {
+    long cores = sysconf(_SC_NPROCESSORS_ONLN);
+    if (cores < 1) return 1;
+    if (cores > RUNNER_MAX_THREADS) return RUNNER_MAX_THREADS;
+    return (int)cores;
+}
+
+static void print_usage(const char* program) {
+    printf("用法: %s [项目根目录] [-j 线程数，0 为全部核心] [-v 列出每个用例]\n", program);
+}
+
+#ifndef TESTING
+int main(int argc, char* argv[]) {
+    const char* root = ".";
+    int threads = 0;
+    bool verbose = false;
+
+    // 解析命令行参数
+    for (int i = 1; i < argc; i++) {
+        if (i + 1 < argc && strcmp(argv[i], "-j") == 0) {
+            threads = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "-v") == 0) {
+            verbose = true;
+        } else if (argv[i][0] != '-') {
+            root = argv[i];
+        } else {
+            print_usage(argv[0]);
+            return 1;
+        }
+    }
+    if (threads <= 0) {
+        threads = default_thread_count();
+    }
+    if (threads > RUNNER_MAX_THREADS) {
+        threads = RUNNER_MAX_THREADS;
+    }
+
+    int case_count = 0;
+    int status_count = 0;
+    TestCase* cases = list_cases(root, &case_count);
+    StatusEntry* statuses = load_statuses(root, &status_count);
+    if (!cases || case_count == 0) {
+        printf("❌ 没有找到测试用例\n");
+        free(cases);
+        free(statuses);
+        return 1;
+    }
+
+    int counts[TEST_UNKNOWN + 1] = { 0 };
+    int command_cases = 0;
+    int* queue = (int*)malloc(sizeof(int) * (size_t)case_count);
+    int queue_count = 0;
+    for (int i = 0; i < case_count; i++) {
+        cases[i].status = status_of(statuses, status_count, cases[i].name);
+        counts[cases[i].status]++;
+        if (cases[i].status != TEST_ACTIVE && cases[i].status != TEST_WIP) {
+            continue;
+        }
+        char args[RUNNER_PATH_SIZE];
+        snprintf(args, sizeof(args), "%s/tests/integration/%s/args.txt", root, cases[i].name);
+        if (file_exists(args)) {
+            command_cases++;
+            continue;
+        }
+        queue[queue_count++] = i;
+    }
+    free(statuses);
+
+    printf("🚀 进程内并行集成测试（%d 线程）\n", threads);
+    printf("📋 测试分类统计: 活跃 %d, 开发中 %d, 待实现 %d, 禁用 %d\n",
+           counts[TEST_ACTIVE], counts[TEST_WIP], counts[TEST_PENDING], counts[TEST_DISABLED]);
+    if (command_cases) {
+        printf("📋 命令行用例 %d 个（需要独立启动程序，由 make test 运行）\n", command_cases);
+    }
+
+    // 共享的只读表必须在启动线程前初始化
+    output_select(OUTPUT_BACKEND_NULL);
+    board_init();
+    init_characters();
+    register_builtin_commands();
+
+    RunnerShared shared = { root, cases, queue, queue_count, 0 };
+    RunnerWorker* workers = (RunnerWorker*)calloc((size_t)threads, sizeof(RunnerWorker));
+    pthread_t* handles = (pthread_t*)malloc(sizeof(pthread_t) * (size_t)threads);
+    if (!workers || !handles || !queue) {
+        printf("❌ 内存不足\n");
+        return 1;
+    }
+    for (int i = 0; i < threads; i++) {
+        workers[i].shared = &shared;
+        workers[i].ctx = (GameContext*)malloc(sizeof(GameContext));
+        workers[i].scratch = (GameContext*)malloc(sizeof(GameContext));
+        workers[i].dump_capacity = 16 * 1024;
+        workers[i].dump = (char*)malloc(workers[i].dump_capacity);
+        if (!workers[i].ctx || !workers[i].scratch || !workers[i].dump) {
+            printf("❌ 内存不足\n");
+            return 1;
+        }
+    }
+    double start = now_seconds();
+    int started = 0;
+    for (; started < threads; started++) {
+        if (pthread_create(&handles[started], NULL, runner_worker_main, &workers[started]) != 0) {
+            break;
+        }
+    }
+    // 线程创建失败时由已启动的线程领取剩余用例
+    if (started == 0) {
+        runner_worker_main(&workers[0]);
+    }
+    for (int i = 0; i < started; i++) {
+        pthread_join(handles[i], NULL);
+    }
+    double elapsed = now_seconds() - start;
+
+    int passed = 0;
+    int failed = 0;
+    for (int i = 0; i < queue_count; i++) {
+        const TestCase* test = &cases[queue[i]];
+        if (test->passed) {
+            passed++;
+            if (verbose) {
+                printf("✅ %s\n", test->name);
+            }
+        } else {
+            failed++;
+            printf("❌ %s%s: %s\n", test->name, test->status == TEST_WIP ? " (wip)" : "", test->reason);
+        }
+    }
+
+    printf("============================================================\n");
+    printf("执行测试数: %d\n", passed + failed);
+    printf("通过数量: %d\n", passed);
+    printf("失败数量: %d\n", failed);
+    if (counts[TEST_PENDING]) {
+        printf("待实现数量: %d\n", counts[TEST_PENDING]);
+    }
+    if (counts[TEST_DISABLED]) {
+        printf("禁用数量: %d\n", counts[TEST_DISABLED]);
+    }
+    if (passed + failed > 0) {
+        printf("通过率: %.1f%%\n", passed * 100.0 / (passed + failed));
+    }
+    printf("用时: %.3f 秒\n", elapsed);
+    printf(failed == 0 ? "✅ 所有活跃测试通过！\n" : "❌ 部分测试失败\n");
+
+    for (int i = 0; i < threads; i++) {
+        free(workers[i].ctx);
+        free(workers[i].scratch);
+        free(workers[i].dump);
+    }
+    free(workers);
+    free(handles);
+    free(queue);
+    free(cases);
+    return failed == 0 ? 0 : 1;
+}
+#endif
@@ -0,0 +1,17 @@
+#ifndef JSON_COMPARE_H
+#define JSON_COMPARE_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include "../../src/utils/json_reader.h"
+
+// 与 run_agile_tests.py 相同的比较规则：
+//   只比较期望文件中出现的键，实际文件多出的键和数组末尾多出的元素忽略
+//   placed_prop.barrier 按多重集合比较（顺序无关）
+//   placed_prop.bomb 视为空数组（炸弹功能已删除）
+//   数值按值比较，true/false 与 1/0 相等
+// 不一致时在 reason 中写出第一处差异的路径
+bool json_expected_match(const JsonDocument* expected, const JsonDocument* actual,
+                         char* reason, size_t reason_size);
+
+#endif // JSON_COMPARE_H
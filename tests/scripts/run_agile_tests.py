@@ -8,6 +8,7 @@ import os
 import sys
 import subprocess
 import json
+import shlex
 import difflib
 from pathlib import Path
 
@@ -193,27 +194,48 @@ class AgileTestManager:
             with open(input_file, 'r', encoding='utf-8') as f:
                 input_data = f.read()
             
-            # 构建命令
-            cmd = [str(self.game_binary)]
-            if preset_file.exists():
-                cmd.extend(["-i", str(preset_file)])
+            # 构建命令：有 args.txt 时按其中的各行依次调用，否则直接加载预设运行
+            commands = self.load_commands(test_dir)
+            if commands is None:
+                cmd = [str(self.game_binary)]
+                if preset_file.exists():
+                    cmd.extend(["-i", str(preset_file)])
+                commands = [cmd]
+            else:
+                print(f"📋 使用命令文件: args.txt（{len(commands)} 次调用）")
             
-            # 执行程序
-            result = subprocess.run(
-                cmd,
-                input=input_data,
-                text=True,
-                capture_output=True,
-                timeout=30,
-                cwd=test_dir
-            )
+            stdout_parts = []
+            for cmd in commands:
+                # 比较的是最后一次调用留下的 dump.json
+                if dump_file.exists():
+                    dump_file.unlink()
+                
+                # 执行程序
+                result = subprocess.run(
+                    cmd,
+                    input=input_data,
+                    text=True,
+                    capture_output=True,
+                    timeout=30,
+                    cwd=test_dir
+                )
+                stdout_parts.append(result.stdout)
+                
+                if result.stderr:
+                    print(f"⚠️  程序stderr: {result.stderr}")
+                if result.returncode != 0:
+                    break
             
             # 保存输出
             with open(output_file, 'w', encoding='utf-8') as f:
-                f.write(result.stdout)
+                f.write(''.join(stdout_parts))
+            self.remove_temp_files(test_dir)
             
-            if result.stderr:
-                print(f"⚠️  程序stderr: {result.stderr}")
+            if result.returncode != 0:
+                print(f"❌ 程序退出码 {result.returncode}: {' '.join(cmd[1:])}")
+                test_result['reason'] = f"程序退出码 {result.returncode}"
+                self.results.append(test_result)
+                return False
             
         except subprocess.TimeoutExpired:
             print("❌ 测试超时")
@@ -255,6 +277,26 @@ class AgileTestManager:
         self.results.append(test_result)
         return test_passed
     
+    def load_commands(self, test_dir):
+        """读取可选的 args.txt：每个非空行是一次程序调用的命令行参数，# 开头为注释
+        调用在用例目录中依次执行，标准输入都是 input.txt，任一次退出码非零即失败
+        调用过程中生成的临时文件以 tmp_ 开头，用例结束后删除"""
+        args_file = test_dir / "args.txt"
+        if not args_file.exists():
+            return None
+        commands = []
+        with open(args_file, 'r', encoding='utf-8') as f:
+            for line in f:
+                line = line.strip()
+                if line and not line.startswith('#'):
+                    commands.append([str(self.game_binary)] + shlex.split(line))
+        return commands
+    
+    def remove_temp_files(self, test_dir):
+        """删除 args.txt 中的调用生成的临时文件"""
+        for temp_file in test_dir.glob("tmp_*"):
+            temp_file.unlink()
+    
     def force_bomb_to_zero(self, dump_file):
         """强制将dump.json中所有玩家的prop中的bomb属性设为0"""
         try:
@@ -8,6 +8,7 @@ import os
 import sys
 import subprocess
 import json
+import shlex
 import difflib
 from pathlib import Path
 
@@ -50,22 +51,36 @@ class IntegrationTestRunner:
             with open(input_file, 'r', encoding='utf-8') as f:
                 cmd_input = f.read()
             
-            result = subprocess.run(
-                [str(self.game_binary)],
-                input=cmd_input,
-                text=True,
-                capture_output=True,
-                timeout=30,
-                cwd=str(test_dir)
-            )
+            # 有 args.txt 时按其中的各行依次调用，比较最后一次调用留下的 dump.json
+            commands = self.load_commands(test_dir) or [[str(self.game_binary)]]
+            stdout_parts = []
+            for cmd in commands:
+                if dump_file.exists():
+                    dump_file.unlink()
+                result = subprocess.run(
+                    cmd,
+                    input=cmd_input,
+                    text=True,
+                    capture_output=True,
+                    timeout=30,
+                    cwd=str(test_dir)
+                )
+                stdout_parts.append(result.stdout)
+                if result.returncode != 0:
+                    break
             
             # 保存输出文件（便于检查日志）
             with open(output_file, 'w', encoding='utf-8') as f:
-                f.write(result.stdout.rstrip() + '\n')
+                f.write(''.join(stdout_parts).rstrip() + '\n')
+            for temp_file in test_dir.glob("tmp_*"):
+                temp_file.unlink()
             
+            if result.returncode != 0:
+                print(f"❌ 程序退出码 {result.returncode}: {' '.join(cmd[1:])}")
+                return False
             
             # 检查是否有dump命令，如果有则保存dump.json
-            if "dump" in cmd_input:
+            if "dump" in cmd_input or (test_dir / "args.txt").exists():
                 # 从输出中提取dump文件路径
                 lines = result.stdout.split('\n')
                 dump_path = None
@@ -112,6 +127,19 @@ class IntegrationTestRunner:
         
         return test_passed
     
+    def load_commands(self, test_dir):
+        """读取可选的 args.txt：每个非空行是一次程序调用的命令行参数，# 开头为注释"""
+        args_file = test_dir / "args.txt"
+        if not args_file.exists():
+            return None
+        commands = []
+        with open(args_file, 'r', encoding='utf-8') as f:
+            for line in f:
+                line = line.strip()
+                if line and not line.startswith('#'):
+                    commands.append([str(self.game_binary)] + shlex.split(line))
+        return commands
+    
     def force_bomb_to_zero(self, dump_file):
         """强制将dump.json中所有玩家的prop中的bomb属性设为0"""
         try:
@@ -0,0 +1,53 @@
+// 地图加载：示例地图编译出正确的查找表，格式不符的地图给出指明位置的错误
+
+#include "unit_check.h"
+#include "../../src/io/board_loader.h"
+#include <stdio.h>
+#include <string.h>
+
+#define SAMPLE_BOARD "tests/integration/test_custom_board/board.json"
+
+static Board s_board;
+
+static void check_sample_board(void) {
+    char path[1024];
+    char error[256] = "";
+    if (!CHECK_INT(board_load(&s_board, check_path(SAMPLE_BOARD, path, sizeof(path)), error, sizeof(error)), 0)) {
+        printf("      （%s）\n", error);
+        return;
+    }
+    CHECK_INT(s_board.size, 16);
+    CHECK_INT(s_board.tiles[0].kind, TILE_START);
+    CHECK_INT(s_board.tiles[4].kind, TILE_PROP_SHOP);
+    CHECK_INT(s_board.tiles[7].kind, TILE_GIFT_HOUSE);
+    // 地价：地段默认价或格子自身的 price
+    CHECK_INT(s_board.tiles[1].price, 150);
+    CHECK_INT(s_board.tiles[3].price, 250);
+    CHECK_INT(s_board.tiles[5].price, 400);
+    CHECK_INT(s_board.tiles[9].district, 3);
+    CHECK_INT(s_board.tiles[13].credit, 80);
+    CHECK_INT(s_board.tiles[13].symbol, '#');
+    // 显示布局与位置双向对应
+    CHECK_INT(s_board.rows, 5);
+    CHECK_INT(s_board.tile_cell[8], 4 * 5 + 4);
+    CHECK_INT(s_board.cell_tile[2 * 5 + 0], 14);
+}
+
+// 加载应当失败，且错误信息含有 expected
+static void expect_error(const char* file, const char* expected) {
+    char path[1024];
+    char error[256] = "";
+    CHECK(board_load(&s_board, check_path(file, path, sizeof(path)), error, sizeof(error)) != 0);
+    if (!CHECK(strstr(error, expected) != NULL)) {
+        printf("      （%s 的错误为: %s）\n", file, error);
+    }
+}
+
+void check_board(void) {
+    check_sample_board();
+    expect_error("tests/unit/data/board_overlap.json", "第 2 格与第 1 格的显示坐标重叠");
+    expect_error("tests/unit/data/board_bad_district.json", "第 2 格的 district 必须在 1 到 3 之间");
+    expect_error("tests/unit/data/board_too_small.json", "地图至少需要 2 格");
+    expect_error("tests/unit/data/missing_board.json", "无法读取文件");
+    expect_error("tests/unit/data/malformed_preset.json", "第 7 行第 7 列");
+}
@@ -0,0 +1,145 @@
+// 对局分叉：game_clone 得到的子对局与整体复制的对局继续对弈后状态完全相同，
+// 对象池的槽位按容量取用和归还
+
+#include "unit_check.h"
+#include "../../src/game/fork_pool.h"
+#include "../../src/game/player.h"
+#include "../../src/sim/simulator.h"
+#include <stdio.h>
+#include <string.h>
+
+#define FORK_GAMES 20      // 对局数
+#define FORK_TURNS 400     // 每局至多推进的回合数
+#define FORK_INTERVAL 37   // 每隔多少回合分叉一次
+#define FORK_CONTINUE 60   // 分叉后双方各自继续的回合数
+
+static GameContext s_root;
+static GameContext s_copy;
+static BotSeats s_seats;
+static BotSeats s_copy_seats;
+static BotSeats s_child_seats;
+
+// 推进 turns 个回合（跳过破产玩家不计），对局结束时提前停止
+static void play_turns(GameContext* ctx, int turns) {
+    while (turns > 0 && !ctx->state.game.ended) {
+        if (sim_play_turn(ctx)) {
+            turns--;
+        }
+    }
+}
+
+// 比较两局的对局状态和随机数，不同时返回第一处不同的名称，相同返回 NULL
+static const char* first_difference(const GameContext* a, const GameContext* b) {
+    const GameState* x = &a->state;
+    const GameState* y = &b->state;
+    size_t size = (size_t)a->board->size;
+    size_t words = (size + 63) / 64 * sizeof(uint64_t);
+
+    if (x->player_count != y->player_count) return "player_count";
+    if (memcmp(x->players, y->players, (size_t)x->player_count * sizeof(x->players[0])) != 0) return "players";
+    if (memcmp(x->houses, y->houses, size * sizeof(x->houses[0])) != 0) return "houses";
+    for (int i = 0; i < x->player_count; i++) {
+        const Holdings* h = &x->holdings[i];
+        const Holdings* g = &y->holdings[i];
+        if (h->count != g->count || h->investment != g->investment ||
+            memcmp(h->district_count, g->district_count, sizeof(h->district_count)) != 0 ||
+            memcmp(h->tiles.words, g->tiles.words, words) != 0) {
+            return "holdings";
+        }
+    }
+    if (memcmp(x->occupancy.players, y->occupancy.players, size) != 0 ||
+        memcmp(x->occupancy.alive, y->occupancy.alive, size) != 0) {
+        return "occupancy";
+    }
+    if (memcmp(x->placed_prop.bomb.words, y->placed_prop.bomb.words, words) != 0 ||
+        memcmp(x->placed_prop.barrier.words, y->placed_prop.barrier.words, words) != 0) {
+        return "placed_prop";
+    }
+    if (memcmp(&x->god, &y->god, sizeof(x->god)) != 0) return "god";
+    if (memcmp(&x->game, &y->game, sizeof(x->game)) != 0) return "game";
+    if (memcmp(&a->rng, &b->rng, sizeof(a->rng)) != 0) return "rng";
+    return NULL;
+}
+
+static void start_game(uint64_t stream) {
+    static const char* const names[] = { "greedy", "random", "conservative", "basic" };
+    const BotPolicy* policies[MAX_PLAYERS] = { NULL };
+    for (int i = 0; i < 4; i++) {
+        policies[i] = bot_policy_find(names[i]);
+    }
+    game_context_init(&s_root, 7, stream);
+    bot_seats_init(&s_seats, policies, 7, stream);
+    bot_attach(&s_root, &s_seats);
+    s_root.io.echo_prompts = false;
+    s_root.events.verbosity = VERBOSITY_QUIET;
+    for (int i = 0; i < 4; i++) {
+        create_player_by_character(&s_root, i + 1, 10000);
+    }
+    s_root.state.game.started = true;
+}
+
+// 多局对弈中途分叉：子对局和整体复制的对局使用相同的座位随机流继续，结果应逐项相同；
+// 子对局再分叉一次仍然相同，用过的槽位重新复制后与父对局相同
+static void check_clone_matches_copy(ForkPool* pool) {
+    int forks = 0;
+    int mismatches = 0;
+    for (int g = 0; g < FORK_GAMES; g++) {
+        start_game((uint64_t)g);
+        for (int turn = 0; turn < FORK_TURNS && !s_root.state.game.ended; turn += FORK_INTERVAL) {
+            play_turns(&s_root, FORK_INTERVAL);
+
+            GameContext* child = fork_pool_acquire(pool, &s_root);
+            s_copy = s_root;
+            s_child_seats = s_seats;
+            s_copy_seats = s_seats;
+            bot_attach(child, &s_child_seats);
+            bot_attach(&s_copy, &s_copy_seats);
+            play_turns(child, FORK_CONTINUE);
+            play_turns(&s_copy, FORK_CONTINUE);
+            const char* diff = first_difference(child, &s_copy);
+
+            GameContext* grandchild = fork_pool_acquire(pool, child);
+            bot_attach(grandchild, &s_child_seats);
+            play_turns(grandchild, FORK_CONTINUE);
+            play_turns(&s_copy, FORK_CONTINUE);
+            if (!diff) diff = first_difference(grandchild, &s_copy);
+
+            game_clone(child, &s_root);
+            if (!diff) diff = first_difference(child, &s_root);
+            fork_pool_release(pool, grandchild);
+            fork_pool_release(pool, child);
+
+            forks++;
+            if (diff) {
+                if (mismatches == 0) {
+                    printf("      （第 %d 局第 %d 回合分叉后 %s 不同）\n", g, turn, diff);
+                }
+                mismatches++;
+            }
+        }
+    }
+    CHECK(forks >= FORK_GAMES);
+    CHECK_INT(mismatches, 0);
+}
+
+// 槽位用完时返回 NULL，归还或重置后可以再次取用
+static void check_pool_capacity(ForkPool* pool) {
+    GameContext* a = fork_pool_acquire(pool, &s_root);
+    GameContext* b = fork_pool_acquire(pool, &s_root);
+    CHECK(a != NULL && b != NULL && a != b);
+    CHECK(fork_pool_acquire(pool, &s_root) == NULL);
+    fork_pool_release(pool, a);
+    CHECK(fork_pool_acquire(pool, &s_root) == a);
+    fork_pool_reset(pool);
+    CHECK_INT(pool->free_count, 2);
+}
+
+void check_fork_pool(void) {
+    ForkPool pool;
+    if (!CHECK_INT(fork_pool_init(&pool, 2), 0)) {
+        return;
+    }
+    check_clone_matches_copy(&pool);
+    check_pool_capacity(&pool);
+    fork_pool_destroy(&pool);
+}
@@ -0,0 +1,72 @@
+// 命令日志：文件头记录地图，换了地图的回放被拒绝；写不进去的日志不会当作打开成功
+
+#include "unit_check.h"
+#include "../../src/io/journal.h"
+#include "../../src/io/board_loader.h"
+#include "../../src/game/player.h"
+#include <stdio.h>
+#include <string.h>
+
+#define SAMPLE_BOARD "tests/integration/test_custom_board/board.json"
+
+static GameContext s_ctx;
+static Board s_board;
+
+// 在经典地图上记录一局：两位玩家开局，走一步
+static bool record_game(const char* path) {
+    Journal journal;
+    game_context_init(&s_ctx, 12345, 0);
+    if (!CHECK(journal_open(&journal, path, s_ctx.rng.seed, s_ctx.rng.stream, s_ctx.board))) {
+        return false;
+    }
+    create_player_by_character(&s_ctx, 1, 10000);
+    create_player_by_character(&s_ctx, 2, 10000);
+    journal_record_characters(&journal, &s_ctx, 10000);
+    journal_record_command(&journal, s_ctx.rng.draws, "step 1");
+    journal_close(&journal);
+    return CHECK(!journal.failed);
+}
+
+static void check_board_recorded(void) {
+    char path[256];
+    char board_path[1024];
+    if (!CHECK(check_temp_file(path, sizeof(path))[0] != '\0') || !record_game(path)) {
+        return;
+    }
+
+    ReplayStats stats;
+    CHECK_INT(replay_journal(&s_ctx, path, &stats), REPLAY_OK);
+    CHECK_INT(stats.commands, 1);
+    CHECK_INT(stats.board_size, board_classic()->size);
+    CHECK(strcmp(stats.board_name, board_classic()->name) == 0);
+
+    // 换成自定义地图后拒绝回放，并报告日志记录的地图
+    char error[256] = "";
+    if (CHECK_INT(board_load(&s_board, check_path(SAMPLE_BOARD, board_path, sizeof(board_path)),
+                             error, sizeof(error)), 0)) {
+        board_select(&s_board);
+        CHECK_INT(replay_journal(&s_ctx, path, &stats), REPLAY_BOARD_MISMATCH);
+        CHECK_INT(stats.board_size, board_classic()->size);
+        CHECK_INT(stats.commands, 0);
+        board_select(board_classic());
+    }
+    remove(path);
+}
+
+// 文件头都写不进去时 journal_open 失败
+static void check_write_failure(void) {
+    FILE* probe = fopen("/dev/full", "wb");
+    if (!probe) {
+        return; // 没有 /dev/full 的系统上跳过
+    }
+    fclose(probe);
+    Journal journal;
+    game_context_init(&s_ctx, 12345, 0);
+    CHECK(!journal_open(&journal, "/dev/full", s_ctx.rng.seed, s_ctx.rng.stream, s_ctx.board));
+    CHECK(journal.file == NULL);
+}
+
+void check_journal(void) {
+    check_board_recorded();
+    check_write_failure();
+}
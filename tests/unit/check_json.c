@@ -0,0 +1,151 @@
+// JSON 解析与存档读写：格式错误报告准确的行列且不改动对局，成员只在各自的对象中查找，
+// 紧凑格式的存档不含空白且能原样读回，批处理中保存失败的 dump 会被报告
+
+#include "unit_check.h"
+#include "../../src/io/batch.h"
+#include "../../src/io/json_serializer.h"
+#include "../../src/utils/json_reader.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define MALFORMED_PRESET "tests/unit/data/malformed_preset.json"
+#define ANY_SCRIPT "tests/integration/test_preset_nested_keys/input.txt"
+#define FULL_PRESET "tests/integration/test_snapshot_roundtrip/preset.json"
+
+static GameContext s_ctx;
+static GameContext s_loaded;
+
+typedef struct {
+    const char* text;
+    int line;
+    int column;
+} BadJson;
+
+// 各类错误的出错位置：行从 1 开始，列按字节计
+static const BadJson s_bad_json[] = {
+    { "{\"a\": 1,}", 1, 9 },                 // 对象末尾多余的逗号
+    { "[1, 2\n 3]", 2, 2 },                  // 元素之间缺少逗号
+    { "{\n  \"a\" 1\n}", 2, 7 },             // 键后缺少冒号
+    { "{\"a\": \"abc", 1, 11 },              // 字符串没有结束，指向文本末尾
+    { "{\"a\": tru}", 1, 7 },                // 字面量拼写错误
+    { "{\"a\": 1.}", 1, 9 },                 // 小数点后缺少数字，指向应为数字的位置
+    { "{\"a\": 1}\n\n  x", 3, 3 },           // 根值之后有多余内容
+    { "{\"a\": [1, 2", 1, 12 },              // 内容意外结束
+};
+
+static void check_error_positions(void) {
+    for (size_t i = 0; i < sizeof(s_bad_json) / sizeof(s_bad_json[0]); i++) {
+        JsonDocument doc;
+        JsonError error = { 0, 0, NULL };
+        if (!CHECK(!json_parse(&doc, s_bad_json[i].text, &error))) {
+            json_free(&doc);
+            continue;
+        }
+        if (!CHECK_INT(error.line, s_bad_json[i].line) || !CHECK_INT(error.column, s_bad_json[i].column)) {
+            printf("      （输入: %s）\n", s_bad_json[i].text);
+        }
+        CHECK(error.message != NULL);
+    }
+}
+
+// 预设文件第 6 行的成员后缺少逗号，错误指向第 7 行下一个键的引号
+static void check_malformed_preset(void) {
+    char path[1024];
+    check_path(MALFORMED_PRESET, path, sizeof(path));
+    char* text = read_text_file(path, NULL);
+    if (!CHECK(text != NULL)) {
+        return;
+    }
+
+    JsonError error = { 0, 0, NULL };
+    game_context_init(&s_ctx, 12345, 0);
+    CHECK(load_game_from_json(&s_ctx, text, &error) != 0);
+    CHECK_INT(error.line, 7);
+    CHECK_INT(error.column, 7);
+    CHECK_INT(s_ctx.state.player_count, 0);
+    free(text);
+
+    // 批处理报告的是同一位置
+    char script[1024];
+    BatchStats stats;
+    game_context_init(&s_ctx, 12345, 0);
+    CHECK_INT(run_batch_script(&s_ctx, check_path(ANY_SCRIPT, script, sizeof(script)), path, &stats),
+              BATCH_PRESET_ERROR);
+    CHECK_INT(stats.preset_error.line, 7);
+    CHECK_INT(stats.preset_error.column, 7);
+}
+
+// 同名键嵌套在前面的对象里时，json_member 只返回本层的成员
+static void check_nested_keys(void) {
+    const char* text = "{\"meta\": {\"fund\": 1, \"players\": []}, \"fund\": 2, \"players\": [{\"fund\": 3}]}";
+    JsonDocument doc;
+    if (!CHECK(json_parse(&doc, text, NULL))) {
+        return;
+    }
+    const JsonNode* root = &doc.nodes[0];
+    const JsonNode* fund = json_member(&doc, root, "fund");
+    CHECK(fund != NULL && fund->type == JSON_NUMBER && fund->len == 1 && fund->text[0] == '2');
+    const JsonNode* players = json_member(&doc, root, "players");
+    CHECK(players != NULL && players->type == JSON_ARRAY && json_first(&doc, players) != NULL);
+    CHECK(json_member(&doc, root, "note") == NULL);
+    json_free(&doc);
+}
+
+// 紧凑格式写入文件后读回，状态与写入前相同
+static void check_compact_dump(void) {
+    char preset[1024];
+    char path[256];
+    game_context_init(&s_ctx, 12345, 0);
+    if (!CHECK_INT(load_game_preset(&s_ctx, check_path(FULL_PRESET, preset, sizeof(preset))), 0) ||
+        !CHECK(check_temp_file(path, sizeof(path))[0] != '\0')) {
+        return;
+    }
+
+    CHECK_INT(save_game_dump_with_style(&s_ctx, path, JSON_STYLE_COMPACT), 0);
+    char* text = read_text_file(path, NULL);
+    if (CHECK(text != NULL)) {
+        CHECK(strpbrk(text, " \n\t") == NULL);
+        game_context_init(&s_loaded, 12345, 0);
+        CHECK_INT(load_game_from_json(&s_loaded, text, NULL), 0);
+        CHECK(memcmp(&s_loaded.state.players, &s_ctx.state.players, sizeof(s_ctx.state.players)) == 0);
+        CHECK(memcmp(&s_loaded.state.houses, &s_ctx.state.houses, sizeof(s_ctx.state.houses)) == 0);
+        CHECK_INT(s_loaded.rng.draws, s_ctx.rng.draws);
+    }
+    free(text);
+    remove(path);
+}
+
+// 批处理中 dump 写不进去时不算成功：记下失败的文件，返回 BATCH_DUMP_ERROR
+static void check_batch_dump_failure(void) {
+    char preset[1024];
+    char script[256];
+    if (!CHECK(check_temp_file(script, sizeof(script))[0] != '\0')) {
+        return;
+    }
+    FILE* file = fopen(script, "w");
+    if (!CHECK(file != NULL)) {
+        remove(script);
+        return;
+    }
+    fputs("dump /nonexistent_dir/x.json\nquery\n", file);
+    fclose(file);
+
+    BatchStats stats;
+    game_context_init(&s_ctx, 12345, 0);
+    CHECK_INT(run_batch_script(&s_ctx, script, check_path(FULL_PRESET, preset, sizeof(preset)), &stats),
+              BATCH_DUMP_ERROR);
+    CHECK_INT(stats.commands, 2);
+    CHECK_INT(stats.dump_failures, 1);
+    CHECK(strcmp(stats.failed_dump, "/nonexistent_dir/x.json") == 0);
+    CHECK(s_ctx.io.dump.save == NULL); // 批处理结束后恢复调用方的存档方式
+    remove(script);
+}
+
+void check_json(void) {
+    check_error_positions();
+    check_malformed_preset();
+    check_nested_keys();
+    check_compact_dump();
+    check_batch_dump_failure();
+}
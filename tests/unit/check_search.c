@@ -0,0 +1,85 @@
+// 搜索型机器人：按模拟局数限制时结果确定，能看出买地后下一次过路费就会破产；
+// 时限内一局都没模拟完时改用 rollout 策略的答案
+
+#include "unit_check.h"
+#include "../../src/io/json_serializer.h"
+#include "../../src/sim/bot_search.h"
+#include <stdio.h>
+
+// Q 只有 500，停在 3 号空地（地价 200）；前方 4..9 号都是 A 的 3 级地，过路费 400，
+// 买下后掷出任何点数都会破产，不买则付得起
+#define TOLL_PRESET "tests/unit/data/search_toll.json"
+#define TOLL_LOCATION 3
+#define TOLL_PRICE 200
+
+static GameContext s_ctx;
+static BotSeats s_seats;
+static BotPolicy s_policy;
+
+// 载入局面，Q 座位使用以 config 为参数的 mcts 策略
+static bool load_toll_game(const SearchConfig* config) {
+    char path[1024];
+    game_context_init(&s_ctx, 12345, 0);
+    if (!CHECK_INT(load_game_preset(&s_ctx, check_path(TOLL_PRESET, path, sizeof(path))), 0)) {
+        return false;
+    }
+    search_policy_init(&s_policy, config);
+    const BotPolicy* policies[MAX_PLAYERS] = { &s_policy };
+    bot_seats_init(&s_seats, policies, 7, 0);
+    bot_attach(&s_ctx, &s_seats);
+    s_ctx.io.echo_prompts = false;
+    s_ctx.events.verbosity = VERBOSITY_QUIET;
+    return true;
+}
+
+static bool ask_buy(void) {
+    return s_ctx.decisions.buy_land(&s_ctx, &s_ctx.state.players[0], TOLL_LOCATION, TOLL_PRICE);
+}
+
+// 只按局数限制：单线程和多线程都拒绝购买，重复询问答案不变，且不改动对局
+static void check_refuses_fatal_purchase(void) {
+    SearchConfig config;
+    search_default_config(&config);
+    config.budget_ms = 0;
+    config.max_playouts = 16;
+    config.horizon = 2;
+    for (int threads = 1; threads <= 3; threads++) {
+        config.threads = threads;
+        if (!load_toll_game(&config)) {
+            return;
+        }
+        for (int round = 0; round < 3; round++) {
+            if (!CHECK(!ask_buy())) {
+                printf("      （%d 个线程第 %d 次询问时买下了）\n", threads, round + 1);
+            }
+        }
+        CHECK_INT(s_ctx.state.players[0].fund, 500);
+        CHECK_INT(s_ctx.state.houses[TOLL_LOCATION].owner_id, -1);
+        CHECK_INT(s_ctx.rng.draws, 0);
+    }
+    search_thread_exit();
+}
+
+// 时限极短且不限局数：一局也模拟不完，答案来自 rollout 策略
+static void check_budget_fallback(void) {
+    SearchConfig config;
+    search_default_config(&config);
+    config.budget_ms = 1e-6;
+    config.max_playouts = 0;
+    config.threads = 2;
+
+    config.rollout = NULL; // 默认策略一律买地
+    if (load_toll_game(&config)) {
+        CHECK(ask_buy());
+    }
+    config.rollout = bot_policy_find("conservative"); // 买后现金不足 3000，不买
+    if (load_toll_game(&config)) {
+        CHECK(!ask_buy());
+    }
+    search_thread_exit();
+}
+
+void check_search(void) {
+    check_refuses_fatal_purchase();
+    check_budget_fallback();
+}
@@ -0,0 +1,100 @@
+// 二进制快照：编码解码往返一致，头部或负载被改动的快照一律拒绝加载，且不改动目标对局
+
+#include "unit_check.h"
+#include "../../src/io/json_serializer.h"
+#include "../../src/io/snapshot.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define FIXTURE "tests/integration/test_snapshot_roundtrip/preset.json"
+
+static GameContext s_source;
+static GameContext s_target;
+static GameSnapshot s_snapshot;
+static GameSnapshot s_again;
+
+// 解码一份改动过的快照：应当失败，且目标对局保持原样
+static void expect_rejected(const GameSnapshot* snapshot, size_t size, const char* what) {
+    game_context_init(&s_target, 12345, 0);
+    int fund = s_target.state.players[0].fund;
+    if (!CHECK(snapshot_decode(&s_target, snapshot, size) != 0)) {
+        printf("      （%s 的快照被接受了）\n", what);
+    }
+    CHECK_INT(s_target.state.players[0].fund, fund);
+}
+
+static void check_round_trip(void) {
+    game_context_init(&s_target, 12345, 0);
+    CHECK_INT(snapshot_decode(&s_target, &s_snapshot, sizeof(s_snapshot)), 0);
+    CHECK_INT(s_target.state.player_count, s_source.state.player_count);
+    CHECK_INT(s_target.rng.draws, s_source.rng.draws);
+    // 再次编码应逐字节相同
+    snapshot_encode(&s_target, &s_again);
+    CHECK(memcmp(&s_snapshot, &s_again, sizeof(s_snapshot)) == 0);
+}
+
+static void check_corrupted(void) {
+    GameSnapshot bad;
+
+    bad = s_snapshot;
+    ((unsigned char*)&bad.payload)[offsetof(SnapshotPayload, players)] ^= 0x01;
+    expect_rejected(&bad, sizeof(bad), "负载被改动一个字节");
+
+    bad = s_snapshot;
+    bad.header.version = SNAPSHOT_VERSION + 1;
+    expect_rejected(&bad, sizeof(bad), "版本号不同");
+
+    bad = s_snapshot;
+    bad.header.byte_order = 0x04030201u;
+    expect_rejected(&bad, sizeof(bad), "字节序相反");
+
+    bad = s_snapshot;
+    bad.header.magic[0] = 'X';
+    expect_rejected(&bad, sizeof(bad), "文件标识不同");
+
+    bad = s_snapshot;
+    bad.header.payload_size--;
+    expect_rejected(&bad, sizeof(bad), "负载长度不同");
+
+    expect_rejected(&s_snapshot, sizeof(s_snapshot) - 1, "被截短");
+}
+
+// 经文件读写：磁盘上改动一个字节后 load_game_snapshot 失败
+static void check_corrupted_file(void) {
+    char path[256];
+    if (!CHECK(check_temp_file(path, sizeof(path))[0] != '\0')) {
+        return;
+    }
+    CHECK_INT(save_game_snapshot(&s_source, path), 0);
+    CHECK(is_snapshot_file(path));
+    game_context_init(&s_target, 12345, 0);
+    CHECK_INT(load_game_snapshot(&s_target, path), 0);
+
+    FILE* file = fopen(path, "r+b");
+    if (CHECK(file != NULL)) {
+        long offset = (long)(sizeof(SnapshotHeader) + offsetof(SnapshotPayload, houses));
+        fseek(file, offset, SEEK_SET);
+        int byte = fgetc(file);
+        fseek(file, offset, SEEK_SET);
+        fputc(byte ^ 0x80, file);
+        fclose(file);
+    }
+    game_context_init(&s_target, 12345, 0);
+    CHECK(load_game_snapshot(&s_target, path) != 0);
+    remove(path);
+}
+
+void check_snapshot(void) {
+    char path[1024];
+    game_context_init(&s_source, 12345, 0);
+    if (!CHECK_INT(load_game_preset(&s_source, check_path(FIXTURE, path, sizeof(path))), 0)) {
+        return;
+    }
+    CHECK(snapshot_supported(&s_source));
+    snapshot_encode(&s_source, &s_snapshot);
+
+    check_round_trip();
+    check_corrupted();
+    check_corrupted_file();
+}
@@ -0,0 +1,39 @@
+#ifndef UNIT_CHECK_H
+#define UNIT_CHECK_H
+
+// 单元检查：直接调用模块接口，覆盖集成用例（输入命令、比较 dump）难以表达的行为，
+// 例如错误路径、二进制格式和内部一致性
+// 每条 CHECK 失败时打印位置和表达式并计数，不中断同组中的后续检查
+
+#include <stdbool.h>
+#include <stddef.h>
+
+typedef struct {
+    int checks;
+    int failures;
+} CheckStats;
+
+extern CheckStats g_check_stats;
+
+bool check_report(bool ok, const char* file, int line, const char* expr);
+bool check_int(long long actual, long long expected, const char* file, int line, const char* expr);
+
+#define CHECK(expr) check_report((expr), __FILE__, __LINE__, #expr)
+#define CHECK_INT(actual, expected) \
+    check_int((long long)(actual), (long long)(expected), __FILE__, __LINE__, #actual)
+
+// 项目根目录下的文件路径（检查数据放在 tests/ 下）
+const char* check_path(const char* relative, char* buffer, size_t size);
+
+// 在系统临时目录中创建一个空文件并返回其路径，用完由调用方删除
+const char* check_temp_file(char* buffer, size_t size);
+
+// 各组检查，在 unit_main.c 的列表中登记
+void check_snapshot(void);
+void check_json(void);
+void check_board(void);
+void check_fork_pool(void);
+void check_search(void);
+void check_journal(void);
+
+#endif // UNIT_CHECK_H
@@ -0,0 +1,115 @@
+#define _POSIX_C_SOURCE 200809L
+
+// 单元检查入口：按列表依次运行各组检查，可用组名过滤
+
+#include "unit_check.h"
+#include "../../src/game/character.h"
+#include "../../src/game/board.h"
+#include "../../src/io/command_processor.h"
+#include "../../src/io/output.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+CheckStats g_check_stats;
+static const char* s_root = ".";
+
+typedef struct {
+    const char* name;
+    void (*run)(void);
+} CheckGroup;
+
+static const CheckGroup s_groups[] = {
+    { "snapshot", check_snapshot },
+    { "json", check_json },
+    { "board", check_board },
+    { "fork_pool", check_fork_pool },
+    { "search", check_search },
+    { "journal", check_journal },
+};
+
+bool check_report(bool ok, const char* file, int line, const char* expr) {
+    g_check_stats.checks++;
+    if (!ok) {
+        g_check_stats.failures++;
+        printf("   ❌ %s:%d: %s\n", file, line, expr);
+    }
+    return ok;
+}
+
+bool check_int(long long actual, long long expected, const char* file, int line, const char* expr) {
+    g_check_stats.checks++;
+    if (actual != expected) {
+        g_check_stats.failures++;
+        printf("   ❌ %s:%d: %s 为 %lld，期望 %lld\n", file, line, expr, actual, expected);
+        return false;
+    }
+    return true;
+}
+
+const char* check_path(const char* relative, char* buffer, size_t size) {
+    snprintf(buffer, size, "%s/%s", s_root, relative);
+    return buffer;
+}
+
+const char* check_temp_file(char* buffer, size_t size) {
+    const char* dir = getenv("TMPDIR");
+    snprintf(buffer, size, "%s/rich_unit_XXXXXX", dir && dir[0] ? dir : "/tmp");
+    int fd = mkstemp(buffer);
+    if (fd < 0) {
+        buffer[0] = '\0';
+        return buffer;
+    }
+    close(fd);
+    return buffer;
+}
+
+static void print_usage(const char* program) {
+    printf("用法: %s [项目根目录] [-g 组名]\n", program);
+}
+
+#ifndef TESTING
+int main(int argc, char* argv[]) {
+    const char* only = NULL;
+
+    // 解析命令行参数
+    for (int i = 1; i < argc; i++) {
+        if (i + 1 < argc && strcmp(argv[i], "-g") == 0) {
+            only = argv[++i];
+        } else if (argv[i][0] != '-') {
+            s_root = argv[i];
+        } else {
+            print_usage(argv[0]);
+            return 1;
+        }
+    }
+
+    // 共享的只读表在检查前初始化，与终端和测试运行器相同
+    output_select(OUTPUT_BACKEND_NULL);
+    board_init();
+    init_characters();
+    register_builtin_commands();
+
+    printf("🚀 单元检查\n");
+    int groups = 0;
+    int failed_groups = 0;
+    for (size_t i = 0; i < sizeof(s_groups) / sizeof(s_groups[0]); i++) {
+        if (only && strcmp(only, s_groups[i].name) != 0) {
+            continue;
+        }
+        int failures = g_check_stats.failures;
+        int checks = g_check_stats.checks;
+        s_groups[i].run();
+        bool ok = g_check_stats.failures == failures;
+        printf("%s %s（%d 项）\n", ok ? "✅" : "❌", s_groups[i].name, g_check_stats.checks - checks);
+        groups++;
+        failed_groups += ok ? 0 : 1;
+    }
+
+    printf("============================================================\n");
+    printf("检查组: %d, 检查项: %d, 失败: %d\n", groups, g_check_stats.checks, g_check_stats.failures);
+    printf(failed_groups == 0 ? "✅ 所有单元检查通过！\n" : "❌ 部分单元检查失败\n");
+    return failed_groups == 0 && groups > 0 ? 0 : 1;
+}
+#endif